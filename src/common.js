@@ -7,12 +7,51 @@ class WASMFingerprint {
         this._simdSupport = undefined;
         this._simdBenchmark = null;
         this._workerProfile = null;
+        this._timer = null;
+        this._timerInit = null;
+        this._timerUsers = 0; // retainTimer/releaseTimer: the counter worker stops at zero
+        this._clockResolutionMs = null;
+        this._spinCalibration = null;
+        this.timingMode = null; // 'counter' | 'edge' | 'plain' (auto-selected when null)
+        this._llcKB = null;
+        this._emitter = null;
+        this._frequencySamples = [];
+        this.scheduler = 'plain'; // 'plain' | 'reference' (reference kernel around every probe)
+        this.driftThreshold = 0.08;
+        this._referenceRounds = null;
+        this._referenceBaselineMs = null;
+        this._schedulerStats = null;
+        this.probeEstimates = {}; // per-probe sample statistics from interleaved runs
+        this.relaxedSimdUrl = './build/relaxed-simd-probe.wasm';
+        this._relaxedSimd = null;
+        this.footprintProbeUrl = './build/footprint-probe.wasm';
+        this._footprintProbe = undefined;
+        this.fastConfidenceThreshold = 70; // generateFingerprint({ mode: 'fast' }) escalates below this
+        this._tierUp = null;
+        // Build-matrix variant for initWASM: 'default' (the page's WASMModule), 'auto' (best
+        // variant the client supports, per the manifest) or a variant name from the manifest.
+        // Timings differ between variants, so fingerprints only compare within one variant.
+        this.variant = 'default';
+        this.variantManifestUrl = './build/variants/manifest.json';
+        this.activeVariant = null;
+        this._variantManifest = undefined;
+        this._tierState = new Map(); // kernel name -> warm-up record (see warmUpKernel)
     }
 
     async initWASM() {
         if (this.wasmModule) return this.wasmModule;
         try {
-            this.wasmModule = await WASMModule();
+            this.wasmModule = await this._instantiateSelectedVariant();
+            if (!this.wasmModule) {
+                this.wasmModule = await WASMModule();
+                this.activeVariant = 'default';
+            }
+            // In-kernel timing (probe-clock.c) reads the same clock as timedTest
+            this.wasmModule.probeClock = () => this.now();
+            // A module built from older sources lacks the newer kernels; their probes return null
+            if (typeof this.wasmModule._call_overhead_profile !== 'function') {
+                console.warn('WASM module is older than src/wasm, newer probes will be skipped; rebuild with make');
+            }
             return this.wasmModule;
         } catch (error) {
             console.error('WASM loading failed:', error);
@@ -20,21 +59,707 @@ class WASMFingerprint {
         }
     }
 
+    // Build-matrix manifest (tools/build.py --matrix), or null when no variants were built
+    async loadVariantManifest() {
+        if (this._variantManifest !== undefined) return this._variantManifest;
+        this._variantManifest = null;
+        try {
+            if (typeof fetch !== 'function') return null;
+            const response = await fetch(this.variantManifestUrl);
+            if (response.ok) this._variantManifest = await response.json();
+        } catch (_e) {}
+        return this._variantManifest;
+    }
+
+    // Manifest variants this client can run: SIMD needs engine support, threads need
+    // SharedArrayBuffer on a cross-origin isolated page
+    async supportedVariants() {
+        const manifest = await this.loadVariantManifest();
+        if (!manifest?.variants?.length) return [];
+        const simd = await this.detectSIMDSupport();
+        const threads = typeof SharedArrayBuffer === 'function' &&
+            typeof crossOriginIsolated !== 'undefined' && crossOriginIsolated === true;
+        return manifest.variants.filter(v => (!v.features?.simd || simd) && (!v.features?.threads || threads));
+    }
+
+    // Load a variant's Emscripten glue (distinct EXPORT_NAME, so variants coexist) and
+    // instantiate it with its .wasm resolved next to the manifest
+    async instantiateVariant(entry) {
+        const base = this.variantManifestUrl.slice(0, this.variantManifestUrl.lastIndexOf('/') + 1);
+        const root = typeof window !== 'undefined' ? window : globalThis;
+        if (typeof root[entry.exportName] !== 'function') {
+            if (typeof document === 'undefined') throw new Error('loading a variant needs a DOM');
+            await new Promise((resolve, reject) => {
+                const script = document.createElement('script');
+                script.src = base + entry.js;
+                script.onload = resolve;
+                script.onerror = () => reject(new Error(`failed to load ${entry.js}`));
+                document.head.appendChild(script);
+            });
+        }
+        const factory = root[entry.exportName];
+        if (typeof factory !== 'function') throw new Error(`${entry.exportName} not defined by ${entry.js}`);
+        return factory({ locateFile: (path) => base + path });
+    }
+
+    // initWASM helper: the module for this.variant, or null to fall back to WASMModule
+    async _instantiateSelectedVariant() {
+        if (!this.variant || this.variant === 'default') return null;
+        const candidates = await this.supportedVariants();
+        const entry = this.variant === 'auto'
+            ? [...candidates].sort((a, b) => (b.expectedSpeed ?? 0) - (a.expectedSpeed ?? 0))[0]
+            : candidates.find(v => v.name === this.variant);
+        if (!entry) return null;
+        try {
+            const module = await this.instantiateVariant(entry);
+            this.activeVariant = entry.name;
+            return module;
+        } catch (error) {
+            console.warn(`WASM variant ${entry.name} failed, using default build:`, error);
+            return null;
+        }
+    }
+
+    // Kernel-by-kernel comparison of every supported variant: best-of-5 ms per kernel after
+    // warm-up, and speedup relative to the manifest's default variant. The `speedup` map
+    // can be saved and passed to tools/build.py --speeds to replace the manifest priors.
+    async benchmarkVariants(repeats = 5) {
+        const variants = await this.supportedVariants();
+        if (!variants.length) return null;
+        await this.retainTimer();
+        const KERNELS = [
+            ['sequential_access_test', [256, 200]],
+            ['random_access_test', [256, 200]],
+            ['float_precision_test', [10000]],
+            ['integer_optimization_test', [10000]],
+            ['vector_computation_test', [1000]],
+            ['branch_prediction_test', [5000]],
+            ['reference_kernel', [1 << 16]]
+        ];
+
+        const results = {};
+        for (const entry of variants) {
+            let module;
+            try {
+                module = await this.instantiateVariant(entry);
+            } catch (error) {
+                results[entry.name] = { error: error?.message || String(error) };
+                continue;
+            }
+            const kernels = {};
+            for (const [name, args] of KERNELS) {
+                const fn = module[`_${name}`];
+                if (typeof fn !== 'function') continue;
+                const warm = this.warmUpKernel(`${entry.name}:${name}`, fn, args);
+                let best = Infinity;
+                for (let r = 0; r < repeats; r++) {
+                    best = Math.min(best, this.timedTest(fn, ...args).time);
+                }
+                kernels[name] = { ms: best, tier: warm.tier };
+            }
+            results[entry.name] = { sizeBytes: entry.sizeBytes, flags: entry.flags, kernels };
+            await new Promise(res => setTimeout(res, 0));
+        }
+
+        // Geometric-mean speedup over the kernels both variants ran
+        const manifest = await this.loadVariantManifest();
+        const reference = results[manifest?.default] || Object.values(results).find(r => r.kernels);
+        const speedup = {};
+        for (const [name, result] of Object.entries(results)) {
+            if (!result.kernels || !reference?.kernels) continue;
+            const ratios = Object.entries(result.kernels)
+                .map(([kernel, r]) => reference.kernels[kernel]?.ms / r.ms)
+                .filter(x => isFinite(x) && x > 0);
+            for (const [kernel, r] of Object.entries(result.kernels)) {
+                const ref = reference.kernels[kernel]?.ms;
+                r.speedup = ref > 0 && r.ms > 0 ? ref / r.ms : null;
+            }
+            speedup[name] = ratios.length ? Math.exp(ratios.reduce((a, x) => a + Math.log(x), 0) / ratios.length) : null;
+        }
+        this.releaseTimer();
+        return { reference: manifest?.default ?? null, variants: results, speedup };
+    }
+
+    // Start the shared-memory counter timer when the page is cross-origin isolated
+    async initTimer() {
+        if (this._timerInit) return this._timerInit;
+        this._timerInit = (async () => {
+            if (typeof SharedCounterTimer !== 'function' || !SharedCounterTimer.isSupported()) {
+                return null;
+            }
+            const timer = new SharedCounterTimer();
+            this._timer = (await timer.start()) ? timer : null;
+            // Kernels calibrated against the coarse clock must recalibrate
+            if (this._timer && typeof this.wasmModule?._probe_clock_reset === 'function') {
+                this.wasmModule._probe_clock_reset();
+            }
+            return this._timer;
+        })();
+        return this._timerInit;
+    }
+
+    // Suites hold the counter timer for their duration: its worker keeps one core busy and
+    // would perturb SMT-sibling timings for the page's lifetime if left running. Standalone
+    // measure* callers can end it with stopTimer().
+    async retainTimer() {
+        this._timerUsers++;
+        return this.initTimer();
+    }
+
+    releaseTimer() {
+        if (this._timerUsers > 0) this._timerUsers--;
+        if (this._timerUsers === 0) this.stopTimer();
+    }
+
+    stopTimer() {
+        if (!this._timerInit) return;
+        if (this._timer) this._timer.stop();
+        this._timer = null;
+        this._timerInit = null;
+        // Kernels calibrated against the counter clock must recalibrate on performance.now()
+        if (typeof this.wasmModule?._probe_clock_reset === 'function') {
+            this.wasmModule._probe_clock_reset();
+        }
+    }
+
+    hasHighResTimer() {
+        return !!(this._timer && this._timer.available);
+    }
+
+    // Current time in milliseconds from the best available clock
+    now() {
+        return this.hasHighResTimer() ? this._timer.now() : performance.now();
+    }
+
+    // Smallest observable clock step (milliseconds)
+    timerResolution() {
+        if (this.hasHighResTimer()) return this._timer.resolutionMs;
+        if (this._clockResolutionMs) return this._clockResolutionMs;
+        let min = Infinity;
+        for (let i = 0; i < 20; i++) {
+            const t0 = performance.now();
+            let t1;
+            do { t1 = performance.now(); } while (t1 === t0);
+            min = Math.min(min, t1 - t0);
+        }
+        this._clockResolutionMs = min;
+        return min;
+    }
+
+    // Pick a measurement mode: counter timer, clock-edge alignment on coarse clocks, or plain
+    resolveTimingMode() {
+        if (this.timingMode) return this.timingMode;
+        if (this.hasHighResTimer()) return 'counter';
+        return this.timerResolution() >= 0.005 ? 'edge' : 'plain';
+    }
+
+    // Spin until performance.now() ticks, counting loop iterations
+    _spinToEdge() {
+        const start = performance.now();
+        let spins = 0;
+        let t;
+        do { t = performance.now(); spins++; } while (t === start);
+        return { edge: t, spins };
+    }
+
+    // Calibrate how many spin iterations fit in one millisecond of the coarse clock
+    calibrateSpinRate(ticks = 12) {
+        if (this._spinCalibration) return this._spinCalibration;
+        let prev = this._spinToEdge().edge;
+        const rates = [];
+        for (let i = 0; i < ticks; i++) {
+            const { edge, spins } = this._spinToEdge();
+            const tickMs = edge - prev;
+            if (tickMs > 0) rates.push(spins / tickMs);
+            prev = edge;
+        }
+        rates.sort((a, b) => a - b);
+        const spinsPerMs = rates.length ? rates[Math.floor(rates.length / 2)] : null;
+        const mean = rates.reduce((a, b) => a + b, 0) / Math.max(1, rates.length);
+        const std = Math.sqrt(rates.reduce((acc, r) => acc + Math.pow(r - mean, 2), 0) / Math.max(1, rates.length - 1));
+        const resolution = this.timerResolution();
+        this._spinCalibration = {
+            spinsPerMs,
+            // Leftover-spin conversion error, in milliseconds, for one full tick
+            precisionMs: spinsPerMs ? resolution * (std / spinsPerMs) + 1 / spinsPerMs : resolution
+        };
+        return this._spinCalibration;
+    }
+
+    // Clock-edge aligned measurement: start exactly on a tick, then subtract the spin time
+    // needed to reach the next tick, recovering sub-tick resolution from a coarse clock
+    edgeTimedTest(testFunc, ...args) {
+        const { spinsPerMs } = this.calibrateSpinRate();
+        const start = this._spinToEdge().edge;
+        const result = testFunc(...args);
+        const { edge, spins } = this._spinToEdge();
+        const leftover = spinsPerMs ? spins / spinsPerMs : 0;
+        return {
+            result: result,
+            time: Math.max(0, (edge - start) - leftover)
+        };
+    }
+
+    // Minimum kernel duration that the active timing mode resolves to ~0.5%
+    _minMeasurableMs() {
+        switch (this.resolveTimingMode()) {
+            case 'counter': return Math.max(0.02, this.timerResolution() * 200);
+            case 'edge': return Math.max(0.05, this.calibrateSpinRate().precisionMs * 50);
+            default: return 0.4;
+        }
+    }
+
     // High-precision timing memory test function
     timedTest(testFunc, ...args) {
-        const startTime = performance.now();
+        if (this.resolveTimingMode() === 'edge') {
+            return this.edgeTimedTest(testFunc, ...args);
+        }
+        const startTime = this.now();
         const result = testFunc(...args);
-        const endTime = performance.now();
+        const endTime = this.now();
         return {
             result: result,
             time: endTime - startTime
         };
     }
 
+    // Time one run of the reference kernel, sized once to ~2x the minimum measurable duration
+    _referenceSample() {
+        const Module = this.wasmModule;
+        if (!this._referenceRounds) {
+            const targetMs = Math.max(0.1, this._minMeasurableMs() * 2);
+            let rounds = 4096;
+            while (rounds < (1 << 24) && this.timedTest(Module._reference_kernel, rounds).time < targetMs) {
+                rounds *= 2;
+            }
+            this._referenceRounds = rounds;
+            // Let the kernel reach its optimized tier before any sample counts
+            for (let i = 0; i < 3; i++) this.timedTest(Module._reference_kernel, rounds);
+        }
+        return this.timedTest(Module._reference_kernel, this._referenceRounds).time;
+    }
+
+    // Reset the reference baseline and drift statistics (start of a suite)
+    resetScheduler() {
+        this._referenceBaselineMs = null;
+        this._schedulerStats = { probes: 0, reruns: 0, maxDrift: 0 };
+    }
+
+    // timedTest under the active scheduler. In 'reference' mode the probe is bracketed by
+    // reference samples; time is rescaled to the session's baseline reference so clock and
+    // load changes between probes cancel, and a probe whose brackets disagree by more than
+    // driftThreshold is re-run (up to twice), keeping the steadiest attempt.
+    scheduledTest(testFunc, ...args) {
+        if (this.scheduler !== 'reference' || typeof this.wasmModule?._reference_kernel !== 'function') {
+            return this.timedTest(testFunc, ...args);
+        }
+        if (!this._schedulerStats) this.resetScheduler();
+
+        let best = null;
+        let attempts = 0;
+        for (let attempt = 0; attempt < 3; attempt++) {
+            attempts++;
+            const before = this._referenceSample();
+            const probe = this.timedTest(testFunc, ...args);
+            const after = this._referenceSample();
+            const reference = (before + after) / 2;
+            const drift = Math.min(before, after) > 0 ? Math.abs(after - before) / Math.min(before, after) : Infinity;
+            if (!best || drift < best.drift) {
+                best = { probe, reference, drift };
+            }
+            if (drift <= this.driftThreshold) break;
+        }
+
+        if (this._referenceBaselineMs === null && best.reference > 0) {
+            this._referenceBaselineMs = best.reference;
+        }
+        const stats = this._schedulerStats;
+        stats.probes++;
+        stats.reruns += attempts - 1;
+        if (isFinite(best.drift)) stats.maxDrift = Math.max(stats.maxDrift, best.drift);
+
+        const scale = best.reference > 0 ? this._referenceBaselineMs / best.reference : 1;
+        return {
+            result: best.probe.result,
+            time: best.probe.time * scale,
+            rawTime: best.probe.time,
+            reference: best.reference,
+            drift: best.drift
+        };
+    }
+
+    // Tier-up detection. V8 and SpiderMonkey run WASM in a baseline compiler first (Liftoff,
+    // Baseline) and swap in optimized code per function later. From a cold module, time the
+    // reference kernel call by call: the optimizing tier shows as a persistent step down in
+    // ns per round. Must run before anything else calls reference_kernel; cached per module.
+    async measureTierUp(maxMs = 150) {
+        if (this._tierUp) return this._tierUp;
+        const Module = await this.initWASM();
+        if (typeof Module._reference_kernel !== 'function') return null;
+        const minMs = this._minMeasurableMs();
+        const samples = [];
+        const start = this.now();
+        let rounds = 1024;
+        // The first call includes lazy compilation; it is not a tier sample
+        Module._reference_kernel(1);
+        let calls = 1;
+        while (this.now() - start < maxMs) {
+            const time = this.timedTest(Module._reference_kernel, rounds).time;
+            calls++;
+            if (time < minMs) {
+                rounds = Math.min(1 << 24, rounds * 2);
+                continue;
+            }
+            samples.push({ at: this.now() - start, calls, nsPerRound: time * 1e6 / rounds });
+            const step = this._findTierStep(samples);
+            if (step !== null && samples.length - step >= 16) break;
+        }
+
+        const step = this._findTierStep(samples);
+        const ns = samples.map(s => s.nsPerRound);
+        const median = arr => arr.length ? [...arr].sort((a, b) => a - b)[Math.floor(arr.length / 2)] : null;
+        this._tierUp = {
+            detected: step !== null,
+            timeToTierMs: step !== null ? samples[step].at : null,
+            callsToTier: step !== null ? samples[step].calls : null,
+            baselineNs: step !== null ? median(ns.slice(0, step)) : median(ns),
+            optimizedNs: step !== null ? median(ns.slice(step)) : null,
+            speedup: null,
+            samples: samples.length,
+            // Without a step the kernel was optimized before this point (or never tiered)
+            firstSampleMs: samples.length ? samples[0].at : null,
+            elapsedMs: this.now() - start
+        };
+        if (this._tierUp.optimizedNs > 0) {
+            this._tierUp.speedup = this._tierUp.baselineNs / this._tierUp.optimizedNs;
+        }
+        return this._tierUp;
+    }
+
+    // Index of the first optimized-tier sample: the sample after the last pair of consecutive
+    // samples >33% slower than the steady state (median of the last 8) such that the samples
+    // before it are mostly slow too. Isolated slow samples and pairs are treated as noise.
+    // null while no step exists or fewer than 8 samples follow it.
+    _findTierStep(samples) {
+        if (samples.length < 10) return null;
+        const median = arr => [...arr].sort((a, b) => a - b)[Math.floor(arr.length / 2)];
+        const ns = samples.map(s => s.nsPerRound);
+        const slow = median(ns.slice(-8)) * 1.33;
+        for (let i = ns.length - 9; i > 0; i--) {
+            if (ns[i] > slow && ns[i - 1] > slow && median(ns.slice(0, i + 1)) > slow) {
+                return i + 1;
+            }
+        }
+        return null;
+    }
+
+    // Per-kernel warm-up controller: call fn until its timing settles, i.e. the last `window`
+    // samples agree within `tolerance` and are no faster than the window before (no step still
+    // pending). The argument at `scaleArg` doubles until a call is measurable. A settled kernel
+    // is only tagged 'optimized' with evidence that it tiered up: a step in its own samples
+    // (_findTierStep) or at least as many calls as the reference kernel needed in
+    // measureTierUp. Otherwise it keeps running until maxMs and is tagged 'unconfirmed' (no
+    // tiering, or optimized before the first sample). Records are cached by name.
+    warmUpKernel(name, fn, args, { scaleArg = null, maxMs = 120, window = 4, tolerance = 0.1 } = {}) {
+        const cached = this._tierState.get(name);
+        if (cached?.tier === 'optimized' || cached?.settled) return cached;
+
+        const minMs = this._minMeasurableMs();
+        const callArgs = [...args];
+        const samples = [];
+        const start = this.now();
+        const median = arr => [...arr].sort((a, b) => a - b)[Math.floor(arr.length / 2)];
+        const priorCalls = cached?.calls ?? 0;
+        let calls = 0;
+        let settled = false;
+        let evidence = null;
+        while (!(settled && evidence) && this.now() - start < maxMs) {
+            const time = this.timedTest(fn, ...callArgs).time;
+            calls++;
+            if (time < minMs && scaleArg !== null && callArgs[scaleArg] < (1 << 24)) {
+                callArgs[scaleArg] *= 2;
+                samples.length = 0;
+                continue;
+            }
+            const units = scaleArg !== null ? callArgs[scaleArg] : 1;
+            samples.push({ at: this.now() - start, calls, time, nsPerRound: time * 1e6 / units });
+            if (samples.length >= window * 2) {
+                const last = samples.slice(-window).map(s => s.time);
+                const prev = samples.slice(-window * 2, -window).map(s => s.time);
+                const spread = Math.max(...last) / Math.max(1e-9, Math.min(...last)) - 1;
+                settled = spread <= tolerance && median(last) >= median(prev) * (1 - tolerance);
+            }
+            if (settled && !evidence) {
+                if (this._findTierStep(samples) !== null) {
+                    evidence = 'step';
+                } else if (this._tierUp?.detected && priorCalls + calls >= this._tierUp.callsToTier) {
+                    evidence = 'tier-up';
+                }
+            }
+        }
+
+        const record = {
+            tier: settled && evidence ? 'optimized' : 'unconfirmed',
+            evidence,
+            settled,
+            calls: priorCalls + calls,
+            warmUpMs: this.now() - start,
+            settledMs: samples.length ? median(samples.slice(-window).map(s => s.time)) : null
+        };
+        this._tierState.set(name, record);
+        return record;
+    }
+
+    // Warm the named exports; returns the combined tag for measurements taken with them.
+    // Entries are [name, args, scaleArg, outCount]: with outCount the kernel writes that many
+    // doubles to a scratch buffer passed as its first argument (scaleArg indexes `args`).
+    ensureOptimizedTier(Module, kernels) {
+        let tier = 'optimized';
+        for (const [name, args, scaleArg = null, outCount = 0] of kernels) {
+            const fn = Module[`_${name}`];
+            if (typeof fn !== 'function') continue;
+            const ptr = outCount ? Module._malloc(outCount * 8) : 0;
+            if (outCount && !ptr) {
+                tier = 'unconfirmed';
+                continue;
+            }
+            try {
+                const record = this.warmUpKernel(name, fn, outCount ? [ptr, ...args] : args,
+                    { scaleArg: outCount && scaleArg !== null ? scaleArg + 1 : scaleArg });
+                if (record.tier !== 'optimized') tier = 'unconfirmed';
+            } finally {
+                if (ptr) Module._free(ptr);
+            }
+        }
+        return tier;
+    }
+
+    // Call a kernel that writes `count` doubles to an output buffer passed as its first argument
+    _callWithOutput(Module, fn, count, ...args) {
+        const ptr = Module._malloc(count * 8);
+        if (!ptr) return null;
+        try {
+            const ret = fn(ptr, ...args);
+            // Read HEAPF64 after the call: memory growth inside the kernel replaces the view
+            const out = Array.from(Module.HEAPF64.subarray(ptr >> 3, (ptr >> 3) + count));
+            return { ret, out };
+        } finally {
+            Module._free(ptr);
+        }
+    }
+
+    // Chase steps needed for an in-kernel measurement to resolve ~0.5% at `nsPerStep`
+    _chaseSteps(nsPerStep = 5, minSteps = 20000, maxSteps = 2000000) {
+        const steps = Math.round(this._minMeasurableMs() * 1e6 / nsPerStep);
+        return Math.max(minSteps, Math.min(maxSteps, steps));
+    }
+
+    // TLB reach and page-walk penalty via page-granular randomized pointer chase
+    async measureTLBProfile(maxPages = 16384) {
+        const Module = await this.initWASM();
+        await this.initTimer();
+        if (typeof Module._tlb_reach_profile !== 'function') {
+            return null;
+        }
+
+        const tier = this.ensureOptimizedTier(Module, [['tlb_reach_profile', [16, 1000], 1, 128]]);
+        const call = this._callWithOutput(Module, Module._tlb_reach_profile, 128, maxPages, this._chaseSteps(5));
+        if (!call || call.ret < 0) return null;
+
+        const out = call.out;
+        let k = 5;
+        const readCurve = () => {
+            const n = out[k++];
+            const curve = {};
+            for (let i = 0; i < n; i++, k += 2) curve[out[k]] = out[k + 1];
+            return curve;
+        };
+        const pageCurve = readCurve();
+        const hugeStrideCurve = readCurve();
+
+        return {
+            l1DtlbEntries: out[0],
+            stlbEntries: out[1],
+            walkPenaltyNs: out[2],
+            l1MissPenaltyNs: out[3],
+            hugePagesLikely: out[4] === 1,
+            pageCurve,
+            hugeStrideCurve,
+            tier
+        };
+    }
+
+    // Record the measured last-level cache size so cache_flush evicts all of it
+    configureCacheFlush({ llcKB = null } = {}) {
+        if (typeof llcKB === 'number' && isFinite(llcKB) && llcKB > 0) {
+            this._llcKB = llcKB;
+        }
+    }
+
+    // Eviction size: 1.5x the LLC (32MB assumed until measured), clamped to 8–96MB
+    _cacheFlushBytes() {
+        const llcKB = this._llcKB || 32768;
+        const bytes = Math.round(llcKB * 1024 * 1.5);
+        return Math.min(96 * 1024 * 1024, Math.max(8 * 1024 * 1024, bytes));
+    }
+
+    // Evict caches before a cold-start measurement
+    flushCaches() {
+        const Module = this.wasmModule;
+        if (!Module) return;
+        try {
+            if (typeof Module._cache_flush === 'function') {
+                Module._cache_flush(this._cacheFlushBytes());
+            } else {
+                Module._random_access_test(8192, 3);  // Older builds without cache_flush
+            }
+        } catch (_e) {}
+    }
+
+    // Put caches into a known state: 'cold' evicts, 'warm' runs the kernel once untimed
+    prepareCache(mode, warmup) {
+        if (mode === 'warm') {
+            if (typeof warmup === 'function') {
+                try { warmup(); } catch (_e) {}
+            }
+            return;
+        }
+        this.flushCaches();
+    }
+
+    // Seeded PRNG (mulberry32) so interleaved probe orders are reproducible
+    _seededRandom(seed) {
+        let state = seed >>> 0;
+        return () => {
+            state = (state + 0x6D2B79F5) >>> 0;
+            let t = state;
+            t = Math.imul(t ^ (t >>> 15), t | 1);
+            t ^= t + Math.imul(t ^ (t >>> 7), t | 61);
+            return ((t ^ (t >>> 14)) >>> 0) / 4294967296;
+        };
+    }
+
+    _shuffle(items, random) {
+        const out = items.slice();
+        for (let i = out.length - 1; i > 0; i--) {
+            const j = Math.floor(random() * (i + 1));
+            [out[i], out[j]] = [out[j], out[i]];
+        }
+        return out;
+    }
+
+    // Mean, median and 95% t-interval of the mean
+    _sampleStats(values) {
+        const xs = values.filter(v => typeof v === 'number' && isFinite(v));
+        const n = xs.length;
+        if (!n) return { n: 0, mean: NaN, median: NaN, std: NaN, rsd: 1, ci: [NaN, NaN], ciRel: Infinity };
+        const sorted = [...xs].sort((a, b) => a - b);
+        const median = n % 2 ? sorted[(n - 1) / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+        const mean = xs.reduce((a, b) => a + b, 0) / n;
+        const std = n > 1 ? Math.sqrt(xs.reduce((acc, x) => acc + (x - mean) ** 2, 0) / (n - 1)) : 0;
+        const T95 = [Infinity, 12.71, 4.30, 3.18, 2.78, 2.57, 2.45, 2.36, 2.31, 2.26, 2.23, 2.20, 2.18, 2.16, 2.14, 2.13];
+        const t = n - 1 < T95.length ? T95[n - 1] : 1.96;
+        const half = n > 1 ? t * std / Math.sqrt(n) : Infinity;
+        return {
+            n, mean, median, std,
+            rsd: mean > 0 ? std / mean : 1,
+            ci: [mean - half, mean + half],
+            ciRel: mean > 0 ? half / mean : Infinity
+        };
+    }
+
+    // Interleaved memory tests: every round runs all (size, kind) probes once in a fresh
+    // seeded order, so warm-up and clock ramps spread evenly over sequential and random
+    // instead of always favouring whichever runs second. Rounds continue until each size's
+    // per-round ratio has a 95% CI within targetRsd of its mean (3..12 rounds).
+    async _runMemoryTestsInterleaved(Module, sizes, startIterations, targetRsd, cacheMode, seed) {
+        const minMeasurableMs = this._minMeasurableMs();
+        const random = this._seededRandom(seed);
+        const kernels = { seq: Module._sequential_access_test, rnd: Module._random_access_test };
+        const measure = (kind, size, iters) => {
+            this.prepareCache(cacheMode, () => kernels[kind](size, 1));
+            return this.scheduledTest(kernels[kind], size, iters).time;
+        };
+
+        // Size each probe so both kinds are measurable
+        const iterations = {};
+        for (const size of sizes) {
+            let iters = startIterations;
+            while (iters < 20000 && Math.min(measure('seq', size, iters), measure('rnd', size, iters)) < minMeasurableMs) {
+                iters = Math.min(20000, Math.floor(iters * 1.8) + 1);
+            }
+            iterations[size] = iters;
+        }
+
+        const probes = sizes.flatMap(size => [{ size, kind: 'seq' }, { size, kind: 'rnd' }]);
+        const samples = Object.fromEntries(sizes.map(size => [size, { seq: [], rnd: [], ratio: [] }]));
+        let rounds = 0;
+        while (rounds < 12) {
+            const round = {};
+            for (const probe of this._shuffle(probes, random)) {
+                round[`${probe.size}:${probe.kind}`] = measure(probe.kind, probe.size, iterations[probe.size]);
+            }
+            for (const size of sizes) {
+                const seq = round[`${size}:seq`], rnd = round[`${size}:rnd`];
+                samples[size].seq.push(seq);
+                samples[size].rnd.push(rnd);
+                if (seq > 0 && rnd > 0) samples[size].ratio.push(rnd / seq);
+            }
+            rounds++;
+            await new Promise(res => setTimeout(res, 0));
+            if (rounds >= 3 && sizes.every(size => this._sampleStats(samples[size].ratio).ciRel <= targetRsd)) break;
+        }
+
+        const results = {};
+        const timingMode = this.resolveTimingMode();
+        for (const size of sizes) {
+            const sStats = this._sampleStats(samples[size].seq);
+            const rStats = this._sampleStats(samples[size].rnd);
+            const ratioStats = this._sampleStats(samples[size].ratio);
+            this.probeEstimates[`mem:${size}KB:seq`] = sStats;
+            this.probeEstimates[`mem:${size}KB:rnd`] = rStats;
+            this.probeEstimates[`mem:${size}KB:ratio`] = ratioStats;
+            results[`${size}KB`] = {
+                timingMode,
+                cacheMode,
+                order: 'interleaved',
+                rounds,
+                sequential: { time: sStats.median, mean: sStats.mean, rsd: sStats.rsd, ci: sStats.ci, iterations: iterations[size] },
+                random: { time: rStats.median, mean: rStats.mean, rsd: rStats.rsd, ci: rStats.ci, iterations: iterations[size] },
+                ratio: ratioStats.n ? ratioStats.median : 'Too Fast',
+                ratioCI: ratioStats.ci
+            };
+        }
+        return results;
+    }
+
     // Memory access test (adaptive timing, debounce)
-    async runMemoryTests(sizes = [16, 32, 64, 256], baseIterations = 200, targetRsd = 0.07) {
+    // options.cacheMode: 'cold' (evict before each kernel, default) or 'warm' (pre-run each kernel)
+    // options.order: 'fixed' (sequential then random per size, default) or 'interleaved'
+    //   (seeded random order across all probes, see _runMemoryTestsInterleaved); options.seed
+    async runMemoryTests(sizes = [16, 32, 64, 256], baseIterations = 200, targetRsd = 0.07, options = {}) {
+        const cacheMode = options.cacheMode || 'cold';
         const Module = await this.initWASM();
+        await this.initTimer();
         const results = {};
+        // With a finer clock (counter timer or edge alignment), kernels can run far shorter
+        const timingMode = this.resolveTimingMode();
+        const minMeasurableMs = this._minMeasurableMs();
+        const startIterations = timingMode === 'counter' ? Math.max(1, Math.floor(baseIterations / 10))
+            : timingMode === 'edge' ? Math.max(1, Math.floor(baseIterations / 4))
+            : baseIterations;
+        // Drift-normalized pairs settle with fewer repetitions
+        const minPairs = this.scheduler === 'reference' ? 3 : 5;
+        // Measure optimized code only: baseline-tier samples would inflate the first sizes
+        const tier = this.ensureOptimizedTier(Module, [
+            ['sequential_access_test', [16, 1], 1],
+            ['random_access_test', [16, 1], 1]
+        ]);
+        if (options.order === 'interleaved') {
+            const interleaved = await this._runMemoryTestsInterleaved(Module, sizes, startIterations, targetRsd, cacheMode, options.seed ?? 0x5eed);
+            for (const entry of Object.values(interleaved)) entry.tier = tier;
+            return interleaved;
+        }
 
         const statsOf = (arr) => {
             if (!arr.length) return { mean: 0, std: 0, rsd: 1, median: 0 };
@@ -55,19 +780,17 @@ class WASMFingerprint {
             else setTimeout(res, 0);
         });
 
-        async function measurePair(size, iters) {
-            // Do lightweight cache eviction first to reduce impact from previous test
-            try { Module._random_access_test(8192, 3); } catch(_e) {}
-            const t0 = performance.now(); Module._sequential_access_test(size, iters); const t1 = performance.now();
-            const seq = t1 - t0;
+        const measurePair = async (size, iters) => {
+            this.prepareCache(cacheMode, () => Module._sequential_access_test(size, 1));
+            const seq = this.scheduledTest(Module._sequential_access_test, size, iters).time;
             await nextTick();
-            const r0 = performance.now(); Module._random_access_test(size, iters); const r1 = performance.now();
-            const rnd = r1 - r0;
+            this.prepareCache(cacheMode, () => Module._random_access_test(size, 1));
+            const rnd = this.scheduledTest(Module._random_access_test, size, iters).time;
             return { seq, rnd, ratio: (rnd > 0 && seq > 0) ? (rnd / seq) : NaN };
-        }
+        };
 
         for (const size of sizes) {
-            let iters = baseIterations;
+            let iters = startIterations;
             let pairs = [];
             // Do one paired measurement first
             pairs.push(await measurePair(size, iters));
@@ -80,9 +803,9 @@ class WASMFingerprint {
                 const rndTimes = pairs.map(p => p.rnd).filter(x => x > 0);
                 const sStats = statsOf(seqTimes);
                 const rStats = statsOf(rndTimes);
-                const tooFast = (sStats.median < 0.4 || rStats.median < 0.4);
+                const tooFast = (sStats.median < minMeasurableMs || rStats.median < minMeasurableMs);
                 const tooNoisy = (sStats.rsd > targetRsd || rStats.rsd > targetRsd);
-                if (!tooFast && !tooNoisy && pairs.length >= 5) break;
+                if (!tooFast && !tooNoisy && pairs.length >= minPairs) break;
                 iters = Math.min(maxIters, Math.floor(iters * 1.8));
                 // Append paired samples
                 pairs.push(await measurePair(size, iters));
@@ -96,6 +819,9 @@ class WASMFingerprint {
             const rStats = statsOf(pairs.map(p => p.rnd));
 
             results[`${size}KB`] = {
+                timingMode,
+                cacheMode,
+                tier,
                 sequential: { time: sStats.median, mean: sStats.mean, rsd: sStats.rsd, iterations: iters },
                 random: { time: rStats.median, mean: rStats.mean, rsd: rStats.rsd, iterations: iters },
                 ratio: ratioMedian
@@ -108,12 +834,20 @@ class WASMFingerprint {
     // Calculation performance test
     async runComputeTests() {
         const Module = await this.initWASM();
+        await this.initTimer();
+        const tier = this.ensureOptimizedTier(Module, [
+            ['float_precision_test', [1000], 0],
+            ['integer_optimization_test', [1000], 0],
+            ['vector_computation_test', [100], 0],
+            ['branch_prediction_test', [500], 0]
+        ]);
 
         return {
             float: this.timedTest(Module._float_precision_test.bind(Module), 10000),
             integer: this.timedTest(Module._integer_optimization_test.bind(Module), 10000),
             vector: this.timedTest(Module._vector_computation_test.bind(Module), 1000),
-            branch: this.timedTest(Module._branch_prediction_test.bind(Module), 5000)
+            branch: this.timedTest(Module._branch_prediction_test.bind(Module), 5000),
+            tier
         };
     }
 
@@ -138,26 +872,617 @@ class WASMFingerprint {
     }
 
     // Measure stride access time (milliseconds, robust statistics)
-    async measureStrideTimes(sizeKB = 512, strides = [64, 128, 256, 512, 4096], iterations = 200) {
+    // options.cacheMode: 'warm' (pre-run once per stride, default) or 'cold' (evict before each sample)
+    // options.order: 'fixed' (ascending strides, default) or 'interleaved' (seeded shuffle of
+    //   all strides each round, 3..9 rounds until each 95% CI is within 10%); options.seed
+    // Returns { times: stride -> ms, tier } so the tier tag stays out of the stride map
+    async measureStrideTimes(sizeKB = 512, strides = [64, 128, 256, 512, 4096], iterations = 200, options = {}) {
         const Module = await this.initWASM();
+        await this.initTimer();
+        const cacheMode = options.cacheMode || 'warm';
         const out = {};
         const samplesPerStride = 3;
+        const warmup = (s) => Module._stride_access_test(sizeKB, s, Math.max(1, Math.floor(iterations/4)));
+        const tier = this.ensureOptimizedTier(Module, [['stride_access_test', [sizeKB, strides[0], 1], 2]]);
+
+        if (options.order === 'interleaved') {
+            const random = this._seededRandom(options.seed ?? 0x5eed);
+            const samples = Object.fromEntries(strides.map(s => [s, []]));
+            for (let round = 0; round < 9; round++) {
+                for (const s of this._shuffle(strides, random)) {
+                    // Each probe re-establishes its own cache state: the previous probe evicted it
+                    this.prepareCache(cacheMode, () => warmup(s));
+                    samples[s].push(this.scheduledTest(Module._stride_access_test, sizeKB, s, iterations).time);
+                }
+                if (round + 1 >= samplesPerStride && strides.every(s => this._sampleStats(samples[s]).ciRel <= 0.1)) break;
+            }
+            for (const s of strides) {
+                const stats = this._sampleStats(samples[s]);
+                this.probeEstimates[`stride:${s}`] = stats;
+                out[s] = stats.median;
+            }
+            return { times: out, tier };
+        }
 
         for (const s of strides) {
             const times = [];
-            // Warm-up
-            try { Module._stride_access_test(sizeKB, s, Math.max(1, Math.floor(iterations/4))); } catch(_e) {}
+            if (cacheMode === 'warm') {
+                this.prepareCache('warm', () => warmup(s));
+            }
             for (let i = 0; i < samplesPerStride; i++) {
-                const t0 = performance.now();
-                Module._stride_access_test(sizeKB, s, iterations);
-                const t1 = performance.now();
-                times.push(t1 - t0);
+                if (cacheMode === 'cold') this.flushCaches();
+                times.push(this.scheduledTest(Module._stride_access_test, sizeKB, s, iterations).time);
             }
             times.sort((a,b)=>a-b);
             const median = times[Math.floor(times.length/2)];
             out[s] = median;
         }
-        return out;
+        return { times: out, tier };
+    }
+
+    // Prefetcher characterization: each pattern timed in-kernel against a random pointer chase.
+    // Efficiency = random-chase ns / pattern ns (1.0 = no prefetch benefit).
+    async measurePrefetchMatrix(sizeKB = 32768) {
+        const Module = await this.initWASM();
+        await this.initTimer();
+        if (typeof Module._prefetch_pattern_test !== 'function') {
+            return null;
+        }
+
+        const PATTERN = { forward: 0, backward: 1, stride: 2, streams: 3, pageLocal: 4, pageCross: 5, random: 6 };
+        const tier = this.ensureOptimizedTier(Module, [['prefetch_pattern_test', [PATTERN.random, 0, 64, 1000], 3]]);
+        const steps = this._chaseSteps(5);
+        const run = (pattern, param = 0) => {
+            const ns = Module._prefetch_pattern_test(pattern, param, sizeKB, steps);
+            return ns > 0 ? ns : null;
+        };
+
+        const baselineNs = run(PATTERN.random);
+        if (!baselineNs) return null;
+        const eff = (ns) => (ns ? baselineNs / ns : null);
+
+        const strides = {};
+        for (const stride of [64, 128, 256, 512, 1024, 2048, 4096, 8192]) {
+            strides[stride] = eff(run(PATTERN.stride, stride));
+        }
+        const streams = {};
+        for (const count of [1, 2, 4, 8, 16, 32]) {
+            streams[count] = eff(run(PATTERN.streams, count));
+        }
+        const pageLocalNs = run(PATTERN.pageLocal, 64);
+        const pageCrossNs = run(PATTERN.pageCross, 64);
+
+        // Summary: widest stride and most streams still at half the unit-stride benefit
+        const forward = eff(run(PATTERN.forward));
+        const backward = eff(run(PATTERN.backward));
+        const lastAbove = (curve, limit) => Object.keys(curve).map(Number)
+            .filter(k => typeof curve[k] === 'number' && curve[k] >= limit)
+            .reduce((a, b) => Math.max(a, b), 0) || null;
+        const halfUnit = forward ? Math.max(1.5, forward / 2) : 1.5;
+
+        return {
+            sizeKB,
+            baselineNs,
+            forward,
+            backward,
+            strides,
+            streams,
+            pageCross: (pageLocalNs && pageCrossNs) ? pageCrossNs / pageLocalNs : null,
+            maxStride: lastAbove(strides, halfUnit),
+            streamCapacity: lastAbove(streams, halfUnit),
+            tier
+        };
+    }
+
+    // Memory-level parallelism: effective latency per access vs number of independent chains
+    async measureMemoryParallelism(sizeKB = 65536) {
+        const Module = await this.initWASM();
+        await this.initTimer();
+        if (typeof Module._mlp_profile !== 'function') {
+            return null;
+        }
+
+        const tier = this.ensureOptimizedTier(Module, [['mlp_profile', [256, 1000], 1, 3 + 2 * 32]]);
+        const call = this._callWithOutput(Module, Module._mlp_profile, 3 + 2 * 32, sizeKB, this._chaseSteps(10));
+        if (!call || call.ret < 0) return null;
+
+        const out = call.out;
+        const curve = {};
+        for (let i = 0; i < out[2]; i++) curve[out[3 + i * 2]] = out[4 + i * 2];
+
+        return {
+            sizeKB,
+            peakSpeedup: out[0],
+            saturationChains: out[1],
+            latencyNs: curve[1] ?? null,
+            curve,
+            tier
+        };
+    }
+
+    // Timed branch predictor profile: mispredict penalty, history depth and loop predictor reach
+    async measureBranchPredictor(maxPeriod = 16384) {
+        const Module = await this.initWASM();
+        await this.initTimer();
+        if (typeof Module._branch_predictor_profile !== 'function') {
+            return null;
+        }
+
+        // The whole profile is too slow to settle within the warm-up budget; warm its kernel
+        const tier = this.ensureOptimizedTier(Module, [['branch_pattern_test', [1, 16, 0, 10000], 3]]);
+        const branches = this._chaseSteps(1, 100000, 2000000);
+        const call = this._callWithOutput(Module, Module._branch_predictor_profile, 8 + 6 * 24, maxPeriod, branches);
+        if (!call) return null;
+
+        const out = call.out;
+        let k = 5;
+        const readCurve = () => {
+            const n = out[k++];
+            const curve = {};
+            for (let i = 0; i < n; i++, k += 2) curve[out[k]] = out[k + 1];
+            return curve;
+        };
+
+        return {
+            predictableNs: out[0],
+            randomNs: out[1],
+            mispredictPenaltyNs: out[2],
+            historyDepth: out[3],
+            loopDepth: out[4],
+            periodCurve: readCurve(),
+            entropyCurve: readCurve(),
+            loopCurve: readCurve(),
+            tier
+        };
+    }
+
+    // Indirect predictor profile over generated call_indirect targets: target capacity and history reach
+    async measureIndirectPredictor(maxTargets = 1024) {
+        const Module = await this.initWASM();
+        await this.initTimer();
+        if (typeof Module._indirect_predictor_profile !== 'function') {
+            return null;
+        }
+
+        const tier = this.ensureOptimizedTier(Module, [['indirect_call_test', [4, 4, 1000], 2]]);
+        const calls = this._chaseSteps(2, 50000, 1000000);
+        const call = this._callWithOutput(Module, Module._indirect_predictor_profile, 8 + 6 * 24, maxTargets, calls);
+        if (!call) return null;
+
+        const out = call.out;
+        let k = 5;
+        const readCurve = () => {
+            const n = out[k++];
+            const curve = {};
+            for (let i = 0; i < n; i++, k += 2) curve[out[k]] = out[k + 1];
+            return curve;
+        };
+
+        return {
+            predictableNs: out[0],
+            randomNs: out[1],
+            mispredictPenaltyNs: out[2],
+            targetCapacity: out[3],
+            historyReach: out[4],
+            targetCurve: readCurve(),
+            periodCurve: readCurve(),
+            tier
+        };
+    }
+
+    // Code footprint module (footprint-probe.c): megabytes of generated blocks, so it is a
+    // separate file fetched on first use. Exposed with the Module-style names _callWithOutput
+    // expects; null when the module is missing.
+    async loadFootprintProbe() {
+        if (this._footprintProbe !== undefined) return this._footprintProbe;
+        this._footprintProbe = null;
+        try {
+            if (typeof WebAssembly !== 'object' || typeof fetch !== 'function') return null;
+            const response = await fetch(this.footprintProbeUrl);
+            if (!response.ok) return null;
+            const module = await WebAssembly.compile(await response.arrayBuffer());
+            const imports = {};
+            for (const imp of WebAssembly.Module.imports(module)) {
+                if (imp.kind !== 'function') continue;
+                imports[imp.module] = imports[imp.module] || {};
+                imports[imp.module][imp.name] = () => 0;
+            }
+            imports.env = { ...imports.env, probe_now_ms: () => this.now() };
+            const instance = await WebAssembly.instantiate(module, imports);
+            const e = instance.exports;
+            if (typeof e._initialize === 'function') e._initialize();
+            this._footprintProbe = {
+                _malloc: e.malloc,
+                _free: e.free,
+                _code_footprint_profile: e.code_footprint_profile,
+                _code_footprint_test: e.code_footprint_test,
+                _probe_clock_reset: e.probe_clock_reset,
+                get HEAPF64() { return new Float64Array(e.memory.buffer); }
+            };
+        } catch (error) {
+            console.warn('Footprint probe unavailable:', error?.message || error);
+        }
+        return this._footprintProbe;
+    }
+
+    // Front-end probe: cost per KB of executed code as the generated code footprint grows
+    async measureCodeFootprint(maxKB = 4096) {
+        await this.initTimer();
+        const Module = await this.loadFootprintProbe();
+        if (!Module || typeof Module._code_footprint_profile !== 'function') {
+            return null;
+        }
+        // Its clock calibration is separate from the main module's; redo it on the current clock
+        Module._probe_clock_reset();
+        // Engine itself and the first blocks; each footprint point also warms its own blocks
+        const tier = this.ensureOptimizedTier(Module, [['code_footprint_test', [0, 16, 2000], 2]]);
+
+        const blockCalls = this._chaseSteps(100, 2000, 40000);
+        const call = this._callWithOutput(Module, Module._code_footprint_profile, 8 + 4 * 24, maxKB, blockCalls);
+        if (!call) return null;
+
+        const out = call.out;
+        let k = 7;
+        const readCurve = () => {
+            const n = out[k++];
+            const curve = {};
+            for (let i = 0; i < n; i++, k += 2) curve[Math.round(out[k])] = out[k + 1];
+            return curve;
+        };
+
+        // Knees are labelled by where they fall: uop cache < 16KB <= L1i < 256KB <= L2
+        const knees = [out[1], out[2], out[3]].filter(v => v > 0);
+        return {
+            blockBytes: out[6],
+            nsPerKB: out[0],
+            branchyNsPerKB: out[4] >= 0 ? out[4] : null,
+            knees,
+            uopKneeKB: knees.find(v => v < 16) ?? null,
+            l1iKneeKB: knees.find(v => v >= 16 && v < 256) ?? (out[5] > 0 && out[5] < 256 ? out[5] : null),
+            l2KneeKB: knees.find(v => v >= 256) ?? null,
+            branchyKneeKB: out[5] > 0 ? out[5] : null,
+            straightCurve: readCurve(),
+            branchyCurve: readCurve(),
+            tier
+        };
+    }
+
+    // Effective clock (GHz) from a dependent i32.add chain; every call is kept as a sample
+    async sampleCpuFrequency(label = null) {
+        const Module = await this.initWASM();
+        await this.initTimer();
+        if (typeof Module._cpu_frequency_estimate !== 'function') {
+            return null;
+        }
+        // A baseline-tier chain would pull the first ('start') sample down
+        this.ensureOptimizedTier(Module, [['cpu_frequency_estimate', [200000], 0]]);
+        const ghz = Module._cpu_frequency_estimate(this._chaseSteps(0.35, 200000, 4000000));
+        if (!(ghz > 0)) return null;
+        this._frequencySamples.push({ time: this.now(), label, ghz });
+        return ghz;
+    }
+
+    // Median/min/max of the samples taken so far; drift is (max - min) / median
+    frequencySummary() {
+        const values = this._frequencySamples.map(s => s.ghz).sort((a, b) => a - b);
+        if (!values.length) return null;
+        const median = values[Math.floor(values.length / 2)];
+        return {
+            medianGHz: median,
+            minGHz: values[0],
+            maxGHz: values[values.length - 1],
+            drift: (values[values.length - 1] - values[0]) / median,
+            samples: this._frequencySamples.slice()
+        };
+    }
+
+    // FP latency (one dependent chain) vs throughput (12 independent chains) per op and type
+    async measureFPPipeline() {
+        const Module = await this.initWASM();
+        await this.initTimer();
+        if (typeof Module._fp_pipeline_profile !== 'function') {
+            return null;
+        }
+
+        const tier = this.ensureOptimizedTier(Module, [['fp_pipeline_profile', [1000], 0, 4 * 5 * 2]]);
+        const iterations = this._chaseSteps(8, 20000, 500000);
+        const call = this._callWithOutput(Module, Module._fp_pipeline_profile, 4 * 5 * 2, iterations);
+        if (!call || call.ret < 1) return null;
+
+        const types = ['f32', 'f64', 'f32x4', 'f64x2'];
+        const ops = ['add', 'mul', 'muladd', 'div', 'sqrt'];
+        const profile = {};
+        types.forEach((type, t) => {
+            const row = {};
+            ops.forEach((op, o) => {
+                const latencyNs = call.out[(t * 5 + o) * 2];
+                const throughputNs = call.out[(t * 5 + o) * 2 + 1];
+                if (latencyNs < 0 || throughputNs <= 0) return;
+                // ~ pipeline depth x ports; frequency cancels out
+                row[op] = { latencyNs, throughputNs, ratio: latencyNs / throughputNs };
+            });
+            profile[type] = Object.keys(row).length ? row : null;
+        });
+        profile.tier = tier;
+        return profile;
+    }
+
+    // Subnormal vs normal operand cost for add, mul and mul+add per type
+    async measureDenormalPenalty() {
+        const Module = await this.initWASM();
+        await this.initTimer();
+        if (typeof Module._denormal_penalty_profile !== 'function') {
+            return null;
+        }
+
+        // Sized for the fast (normal) chains; assisted ones just take longer
+        const tier = this.ensureOptimizedTier(Module, [['denormal_penalty_profile', [1000], 0, 4 * 3 * 2]]);
+        const iterations = this._chaseSteps(8, 10000, 200000);
+        const call = this._callWithOutput(Module, Module._denormal_penalty_profile, 4 * 3 * 2, iterations);
+        if (!call) return null;
+
+        const types = ['f32', 'f64', 'f32x4', 'f64x2'];
+        const ops = ['add', 'mul', 'muladd'];
+        const profile = { worstRatio: call.ret > 0 ? call.ret : null, tier };
+        types.forEach((type, t) => {
+            const row = {};
+            ops.forEach((op, o) => {
+                const normalNs = call.out[(t * 3 + o) * 2];
+                const subnormalNs = call.out[(t * 3 + o) * 2 + 1];
+                if (normalNs <= 0 || subnormalNs <= 0) return;
+                row[op] = { normalNs, subnormalNs, ratio: subnormalNs / normalNs };
+            });
+            profile[type] = Object.keys(row).length ? row : null;
+        });
+        return profile;
+    }
+
+    // Relaxed SIMD probe (relaxed-simd-probe.c): deterministic x86/ARM split from the
+    // host-native results of relaxed madd/swizzle/trunc/laneselect/min on edge-case inputs
+    async probeRelaxedSIMD() {
+        if (this._relaxedSimd) return this._relaxedSimd;
+        const BITS = ['fusedMadd', 'swizzleX86', 'truncNanX86', 'truncUnsignedNeg', 'laneselectX86', 'minX86'];
+        const result = { supported: false, mask: null, arch: null, fma: null, bits: null, raw: null, failureReason: null };
+        try {
+            if (typeof WebAssembly !== 'object' || typeof fetch !== 'function') {
+                throw new Error('WebAssembly or fetch unavailable');
+            }
+            const response = await fetch(this.relaxedSimdUrl);
+            if (!response.ok) throw new Error(`probe module not found (${response.status})`);
+            const bytes = await response.arrayBuffer();
+            // Engines without relaxed SIMD reject the module at validation
+            if (!WebAssembly.validate(bytes)) throw new Error('relaxed SIMD not supported by this engine');
+
+            const module = await WebAssembly.compile(bytes);
+            const imports = {};
+            for (const imp of WebAssembly.Module.imports(module)) {
+                if (imp.kind !== 'function') continue;
+                imports[imp.module] = imports[imp.module] || {};
+                imports[imp.module][imp.name] = () => 0;
+            }
+            const instance = await WebAssembly.instantiate(module, imports);
+            if (typeof instance.exports._initialize === 'function') instance.exports._initialize();
+
+            const mask = instance.exports.relaxed_simd_probe();
+            result.supported = true;
+            result.mask = mask;
+            result.bits = Object.fromEntries(BITS.map((name, i) => [name, !!(mask & (1 << i))]));
+            result.raw = BITS.map((_, i) => (instance.exports.relaxed_simd_probe_raw(i) >>> 0).toString(16));
+            result.fma = result.bits.fusedMadd;
+            // swizzle, NaN trunc, laneselect and min each vote x86 vs ARM
+            const x86Votes = [result.bits.swizzleX86, result.bits.truncNanX86, result.bits.laneselectX86, result.bits.minX86]
+                .filter(Boolean).length;
+            result.arch = x86Votes >= 3 ? 'x86' : x86Votes <= 1 ? 'arm' : 'mixed';
+        } catch (error) {
+            result.failureReason = error?.message || String(error);
+        }
+        this._relaxedSimd = result;
+        return result;
+    }
+
+    // libm fingerprint: the compiled-in musl libm (hashed in WASM) and the engine's Math.*
+    // (hashed here) over the same ~4096 hard-to-round inputs generated by libm_table_test
+    async measureLibmFingerprint(count = 4096) {
+        const Module = await this.initWASM();
+        if (typeof Module._libm_table_test !== 'function') {
+            return null;
+        }
+        const inputsPtr = Module._malloc(count * 16);
+        const resultsPtr = Module._malloc(count * 8);
+        if (!inputsPtr || !resultsPtr) {
+            if (inputsPtr) Module._free(inputsPtr);
+            if (resultsPtr) Module._free(resultsPtr);
+            return null;
+        }
+        try {
+            const start = this.now();
+            const wasmHash = Module._libm_table_test(inputsPtr, resultsPtr, count) >>> 0;
+            const inputs = Module.HEAPF64.slice(inputsPtr >> 3, (inputsPtr >> 3) + count * 2);
+            const wasmResults = Module.HEAPF64.slice(resultsPtr >> 3, (resultsPtr >> 3) + count);
+
+            const FNS = ['sin', 'cos', 'tan', 'exp', 'log', 'pow', 'atan2', 'cbrt'];
+            const evaluate = [
+                Math.sin, Math.cos, Math.tan, Math.exp, Math.log, Math.pow,
+                (x, y) => Math.atan2(y, x), Math.cbrt
+            ];
+            const jsResults = new Float64Array(count);
+            const mismatches = Object.fromEntries(FNS.map(name => [name, 0]));
+            for (let i = 0; i < count; i++) {
+                const fn = i % FNS.length;
+                jsResults[i] = evaluate[fn](inputs[2 * i], inputs[2 * i + 1]);
+                if (!Object.is(jsResults[i], wasmResults[i])) mismatches[FNS[fn]]++;
+            }
+
+            // FNV-1a over the little-endian bytes of each double, as in libm_table_test
+            const bytes = new Uint8Array(jsResults.buffer);
+            let jsHash = 2166136261;
+            for (let i = 0; i < bytes.length; i++) {
+                jsHash = Math.imul(jsHash ^ bytes[i], 16777619) >>> 0;
+            }
+
+            return {
+                count,
+                wasmHash: wasmHash.toString(16).padStart(8, '0'),
+                jsHash: jsHash.toString(16).padStart(8, '0'),
+                mismatches,
+                mismatchTotal: Object.values(mismatches).reduce((a, b) => a + b, 0),
+                elapsedMs: this.now() - start
+            };
+        } finally {
+            Module._free(inputsPtr);
+            Module._free(resultsPtr);
+        }
+    }
+
+    // NaN payload/sign propagation (fp-tests.c): result bit patterns of add, mul, min/max,
+    // conversions and SIMD lanes on crafted NaNs. No timing involved.
+    async probeNaNPropagation() {
+        const Module = await this.initWASM();
+        if (typeof Module._nan_propagation_probe !== 'function' || !Module.HEAPU32) {
+            return null;
+        }
+        const WORDS = 28;
+        const ptr = Module._malloc(WORDS * 4);
+        if (!ptr) return null;
+        try {
+            const hash = Module._nan_propagation_probe(ptr) >>> 0;
+            const words = Array.from(Module.HEAPU32.subarray(ptr >> 2, (ptr >> 2) + WORDS));
+            const hex = words.map(w => w.toString(16).padStart(8, '0'));
+            // 0 * inf in f32 (word 6): x86 default NaN is negative, ARM's positive
+            const defaultNaN = words[6];
+            return {
+                hash: hash.toString(16).padStart(8, '0'),
+                words: hex,
+                defaultNaN: defaultNaN.toString(16).padStart(8, '0'),
+                arch: defaultNaN === 0xFFC00000 ? 'x86' : defaultNaN === 0x7FC00000 ? 'arm' : 'other',
+                minPropagatesPayload: (words[8] & 0x7FFFFF) === 0x412345
+            };
+        } finally {
+            Module._free(ptr);
+        }
+    }
+
+    // Runtime-emitted kernel (wasm-emitter.js), compiled once per parameter set
+    async getEmittedKernel(kind, params = {}) {
+        if (typeof WasmKernelEmitter !== 'function' || !WasmKernelEmitter.isSupported()) {
+            return null;
+        }
+        if (!this._emitter) this._emitter = new WasmKernelEmitter();
+        try {
+            return await this._emitter.getKernel(kind, params);
+        } catch (error) {
+            console.warn(`Emitted kernel ${kind} failed to compile:`, error);
+            return null;
+        }
+    }
+
+    // ns per work unit of an emitted kernel: iterations doubled until measurable, best of 3
+    _timeEmitted(kernel, unitsPerIteration, arg = 1) {
+        const minMs = this._minMeasurableMs();
+        let iterations = 1024;
+        kernel.run(iterations, arg);
+        while (iterations < (1 << 26) && this.timedTest(kernel.run, iterations, arg).time < minMs) {
+            iterations *= 2;
+        }
+        let best = Infinity;
+        for (let i = 0; i < 3; i++) {
+            best = Math.min(best, this.timedTest(kernel.run, iterations, arg).time);
+        }
+        return best * 1e6 / (iterations * unitsPerIteration);
+    }
+
+    // Exact-instruction probes from emitted kernels: add latency/throughput, L1 load, branch miss
+    async measureEmittedKernels() {
+        await this.initTimer();
+        const addLatency = await this.getEmittedKernel('addChain', { length: 64, chains: 1 });
+        if (!addLatency) return null;
+        const addThroughput = await this.getEmittedKernel('addChain', { length: 16, chains: 8 });
+        const faddLatency = await this.getEmittedKernel('addChain', { length: 64, chains: 1, type: 'f64' });
+        const loads = await this.getEmittedKernel('loads', { unroll: 16, stride: 64, sizeBytes: 16384 });
+        const ladderFixed = await this.getEmittedKernel('branchLadder', { rungs: 16, mode: 'fixed' });
+        const ladderRandom = await this.getEmittedKernel('branchLadder', { rungs: 16, mode: 'random' });
+
+        if (loads) new Int32Array(loads.memory.buffer).fill(1);
+        const fixedNs = ladderFixed ? this._timeEmitted(ladderFixed, 16, 0x5a5a5a5a) : null;
+        const randomNs = ladderRandom ? this._timeEmitted(ladderRandom, 16, 12345) : null;
+
+        return {
+            i32AddLatencyNs: this._timeEmitted(addLatency, 64),
+            i32AddThroughputNs: addThroughput ? this._timeEmitted(addThroughput, 16 * 8) : null,
+            f64AddLatencyNs: faddLatency ? this._timeEmitted(faddLatency, 64) : null,
+            l1LoadNs: loads ? this._timeEmitted(loads, 16) : null,
+            branchPredictableNs: fixedNs,
+            // Random rungs miss half the time
+            branchMispredictNs: fixedNs !== null && randomNs !== null ? (randomNs - fixedNs) * 2 : null
+        };
+    }
+
+    // Call-path overhead (call-tests.c), ns per call at 0/1/2/4/8 i32 arguments.
+    // JS->WASM paths are timed here: direct export, Module._x.bind(Module) (runComputeTests),
+    // cwrap and ccall; WASM->WASM direct, call_indirect and WASM->JS imports in-kernel.
+    // boundaryNs is the fixed cost one timedTest call adds to every kernel time.
+    async measureCallOverhead(calls = 200000) {
+        const Module = await this.initWASM();
+        await this.initTimer();
+        if (typeof Module._call_overhead_profile !== 'function' || typeof Module._call_noop0 !== 'function') {
+            return null;
+        }
+        const ARGS = [0, 1, 2, 4, 8];
+        const PATHS = ['direct', 'indirect', 'import'];
+
+        const inWasm = this._callWithOutput(Module, Module._call_overhead_profile, PATHS.length * ARGS.length + 1, calls);
+        if (!inWasm) return null;
+
+        // JS loop floor: same loop calling a JS no-op, so only the boundary remains
+        const jsNoop = (a) => a;
+        const timeLoop = (fn, argc) => {
+            const args = [1, 2, 3, 4, 5, 6, 7, 8].slice(0, argc);
+            let best = Infinity;
+            for (let r = 0; r < 4; r++) {  // first run is warm-up
+                let acc = 0;
+                const start = this.now();
+                for (let i = 0; i < calls; i++) acc ^= fn(...args);
+                const ns = (this.now() - start) * 1e6 / calls;
+                if (r > 0 && ns < best) best = ns;
+                if (acc === 0x7fffffff) best = NaN;  // keeps acc live
+            }
+            return best;
+        };
+        const floorNs = timeLoop(jsNoop, 1);
+
+        const fromJs = { direct: {}, bind: {}, cwrap: {}, ccall: {} };
+        for (const argc of ARGS) {
+            const name = `call_noop${argc}`;
+            const types = new Array(argc).fill('number');
+            const direct = Module[`_${name}`];
+            const bound = direct.bind(Module);
+            const wrapped = typeof Module.cwrap === 'function' ? Module.cwrap(name, 'number', types) : null;
+            const ccall = typeof Module.ccall === 'function'
+                ? (...args) => Module.ccall(name, 'number', types, args)
+                : null;
+            fromJs.direct[argc] = Math.max(0, timeLoop(direct, argc) - floorNs);
+            fromJs.bind[argc] = Math.max(0, timeLoop(bound, argc) - floorNs);
+            fromJs.cwrap[argc] = wrapped ? Math.max(0, timeLoop(wrapped, argc) - floorNs) : null;
+            fromJs.ccall[argc] = ccall ? Math.max(0, timeLoop(ccall, argc) - floorNs) : null;
+        }
+
+        const fromWasm = {};
+        PATHS.forEach((path, p) => {
+            fromWasm[path] = Object.fromEntries(ARGS.map((argc, k) => [argc, inWasm.out[p * ARGS.length + k]]));
+        });
+
+        return {
+            calls,
+            fromJs,
+            fromWasm,
+            jsLoopFloorNs: floorNs,
+            wasmLoopFloorNs: inWasm.out[PATHS.length * ARGS.length],
+            boundaryNs: fromJs.bind[1],
+            // Engine-specific shape: how much the Emscripten wrappers and JS imports cost
+            // relative to a plain export call
+            ccallRatio: fromJs.direct[1] > 0 && fromJs.ccall[1] !== null ? fromJs.ccall[1] / fromJs.direct[1] : null,
+            importRatio: fromWasm.direct[1] > 0 ? fromWasm.import[1] / fromWasm.direct[1] : null
+        };
     }
 
     async profileWorkerCapacity(maxProbe = 24) {
@@ -740,8 +2065,8 @@ class WASMFingerprint {
 
         // Minimal module borrowed from wasm-feature-detect to probe SIMD support
         const simdModuleBytes = new Uint8Array([
-            0, 97, 115, 109, 1, 0, 0, 0, 1, 4, 1, 96, 0, 0, 3, 2, 1, 0,
-            10, 11, 1, 9, 0, 65, 0, 253, 15, 11
+            0, 97, 115, 109, 1, 0, 0, 0, 1, 5, 1, 96, 0, 1, 123, 3, 2, 1, 0,
+            10, 10, 1, 8, 0, 65, 0, 253, 15, 253, 98, 11
         ]);
 
         try {
@@ -783,22 +2108,230 @@ class WASMFingerprint {
         return this._simdBenchmark;
     }
 
+    // WebGL identity without the render-timing pass: renderer strings, extensions and
+    // canvas hashes only (WebGLFingerprinter.generateFingerprint also times draw calls)
+    async _webglDeterministic() {
+        const Fingerprinter = typeof window !== 'undefined' ? window.WebGLFingerprinter : undefined;
+        if (typeof Fingerprinter !== 'function') return null;
+        const webgl = new Fingerprinter();
+        try {
+            if (!await webgl.initialize()) return null;
+            const canvas = webgl.generateCanvasFingerprint();
+            const fingerprint = {
+                basic: webgl.getBasicGPUInfo(),
+                extensions: webgl.getSupportedExtensions(),
+                canvasHash: canvas.primary,
+                canvasVariants: canvas.variants,
+                precision: webgl.getFloatingPointPrecision()
+            };
+            return { fingerprint, analysis: webgl.analyzeGPUModel(fingerprint) };
+        } finally {
+            webgl.cleanup();
+        }
+    }
+
+    // Deterministic-only fingerprint: feature bits, relaxed SIMD / NaN semantics, libm
+    // hashes and WebGL/canvas hashes. No timing loops, so it runs in tens of milliseconds
+    // once the module is loaded; confidence comes from classifyWASM and, when loaded,
+    // DeviceSignatureDatabase.identifyDeviceComprehensive.
+    async generateFastFingerprint() {
+        const start = this.now();
+        await this.initWASM();
+        const probeStart = this.now();
+
+        const simdSupported = await this.detectSIMDSupport();
+        let relaxedSimd = null, nanProbe = null, libm = null, webgl = null;
+        try { relaxedSimd = await this.probeRelaxedSIMD(); } catch(_e) {}
+        try { nanProbe = await this.probeNaNPropagation(); } catch(_e) {}
+        try { libm = await this.measureLibmFingerprint(); } catch(_e) {}
+        try { webgl = await this._webglDeterministic(); } catch(_e) {}
+
+        const nav = typeof navigator !== 'undefined' ? navigator : {};
+        const features = {
+            simd_supported: simdSupported,
+            hardware_concurrency: typeof nav.hardwareConcurrency === 'number' ? nav.hardwareConcurrency : null,
+            relaxed_simd_mask: relaxedSimd?.supported ? relaxedSimd.mask : null,
+            relaxed_simd_arch: relaxedSimd?.arch ?? null,
+            relaxed_simd_fma: relaxedSimd?.fma ?? null,
+            nan_hash: nanProbe?.hash ?? null,
+            nan_default: nanProbe?.defaultNaN ?? null,
+            nan_arch: nanProbe?.arch ?? null,
+            nan_min_payload: nanProbe?.minPropagatesPayload ?? null,
+            libm_wasm_hash: libm?.wasmHash ?? null,
+            libm_js_hash: libm?.jsHash ?? null,
+            libm_js_mismatches: libm?.mismatches ?? null,
+            webgl_renderer: webgl?.fingerprint.basic.renderer ?? null,
+            webgl_vendor: webgl?.analysis.normalizedVendor ?? null,
+            webgl_canvas_hash: webgl?.fingerprint.canvasHash || null,
+            webgl_blend_hash: webgl?.fingerprint.canvasVariants?.blend ?? null,
+            canvas2d_hash: webgl?.fingerprint.canvasVariants?.canvas2d ?? null
+        };
+
+        const classification = await this.classifyWASM({ features, memoryResults: {} });
+        let device = null;
+        const Database = typeof window !== 'undefined' ? window.DeviceSignatureDatabase : undefined;
+        if (typeof Database === 'function') {
+            try {
+                device = new Database().identifyDeviceComprehensive({
+                    cores: features.hardware_concurrency ? { total: features.hardware_concurrency } : null,
+                    webglAnalysis: webgl?.analysis ?? null,
+                    deviceMemory: typeof nav.deviceMemory === 'number' ? nav.deviceMemory : null
+                });
+            } catch(_e) {}
+        }
+
+        const end = this.now();
+        return {
+            mode: 'fast',
+            escalated: false,
+            features,
+            classification,
+            device,
+            confidence: Math.max(classification.confidence, device?.confidence ?? 0),
+            webglAnalysis: webgl?.analysis ?? null,
+            // probeMs excludes the one-off module download/instantiation
+            elapsedMs: end - start,
+            probeMs: end - probeStart,
+            hash: this.calculateHash(features)
+        };
+    }
+
+    // Sequential test over DeviceSignatureDatabase profiles, or null when disabled/unavailable
+    _createSequentialTest(confidence) {
+        if (typeof confidence !== 'number' || !(confidence > 0)) return null;
+        const Database = typeof window !== 'undefined' ? window.DeviceSignatureDatabase : undefined;
+        if (typeof Database !== 'function') return null;
+        const db = new Database();
+        return { db, test: db.createSequentialTest(confidence) };
+    }
+
     // Generate device fingerprint
-    async generateFingerprint() {
+    // options.scheduler: 'plain' (default) or 'reference' (see scheduledTest)
+    // options.order: 'interleaved' (default) or 'fixed' ordering of the memory and stride
+    // probes (other probe families always run once, in a fixed order); options.seed
+    // options.mode: 'full' (default) or 'fast' (deterministic probes only; falls back to the
+    // full timing suite when confidence stays below options.minConfidence)
+    async generateFingerprint(options = {}) {
+        if (options.mode === 'fast') {
+            const fast = await this.generateFastFingerprint();
+            const minConfidence = options.minConfidence ?? this.fastConfidenceThreshold;
+            if (fast.confidence >= minConfidence) {
+                return fast;
+            }
+            const full = await this.generateFingerprint({ ...options, mode: 'full' });
+            return { ...full, mode: 'fast', escalated: true, fast };
+        }
+        await this.initWASM();
+        // options.scheduler applies to this run only
+        const previousScheduler = this.scheduler;
+        if (options.scheduler) this.scheduler = options.scheduler;
+        await this.retainTimer();
+        try {
+            return await this._generateFullFingerprint(options);
+        } finally {
+            this.scheduler = previousScheduler;
+            this.releaseTimer();
+        }
+    }
+
+    async _generateFullFingerprint(options) {
         const Module = await this.initWASM();
-        const memoryResults = await this.runMemoryTests();
-        const computeResults = await this.runComputeTests();
-        const simdBenchmark = await this.measureSIMDCharacteristics(computeResults);
-        const workerProfile = await this.profileWorkerCapacity();
+        this.resetScheduler();
+        const order = options.order || 'interleaved';
+        const seed = options.seed ?? 0x5eed;
+        this.probeEstimates = {};
+        // Clock samples bracket each stage to follow turbo ramp-up and thermal decay
+        this._frequencySamples = [];
+        const sampleClock = async (label) => {
+            try { await this.sampleCpuFrequency(label); } catch(_e) {}
+        };
+
+        // Tier-up timing needs a cold reference kernel, so it runs before every other probe
+        let tierUp = null;
+        try { tierUp = await this.measureTierUp(); } catch(_e) {}
+
+        // options.stopConfidence (e.g. 0.9): sequential test over the device profiles after
+        // every stage; once the top profile dominates the remaining stages are skipped
+        const sequential = this._createSequentialTest(options.stopConfidence);
+        let stoppedAfter = null;
+        const observe = (stage, observations) => {
+            if (!sequential || stoppedAfter) return;
+            sequential.db.updateSequentialTest(sequential.test, observations);
+            if (sequential.test.decided) stoppedAfter = stage;
+        };
+
+        let relaxedSimd = null, nanProbe = null, webgl = null;
+        if (sequential) {
+            // Timing-free evidence first: it often settles the family on its own
+            try { relaxedSimd = await this.probeRelaxedSIMD(); } catch(_e) {}
+            try { nanProbe = await this.probeNaNPropagation(); } catch(_e) {}
+            try { webgl = await this._webglDeterministic(); } catch(_e) {}
+            const arch = [relaxedSimd?.arch, nanProbe?.arch].find(a => a === 'arm' || a === 'x86') ?? null;
+            observe('deterministic', {
+                cores: typeof navigator !== 'undefined' && navigator.hardwareConcurrency || null,
+                arch,
+                webglRenderer: webgl?.fingerprint.basic.renderer || null
+            });
+        }
+
+        await sampleClock('start');
+        let memoryResults = {};
+        if (!stoppedAfter) {
+            memoryResults = await this.runMemoryTests(undefined, undefined, undefined, { order, seed });
+            await sampleClock('memory');
+            observe('memory', { memoryRatio: this._safeOverallRatio(memoryResults) });
+        }
+        let computeResults = null, simdBenchmark = null, workerProfile = null;
+        if (!stoppedAfter) {
+            computeResults = await this.runComputeTests();
+            await sampleClock('compute');
+            simdBenchmark = await this.measureSIMDCharacteristics(computeResults);
+            workerProfile = await this.profileWorkerCapacity();
+            observe('compute', { cores: workerProfile?.hardwareConcurrency ?? null });
+        }
         // Low-level structure detection
-        let l1 = null, l2 = null, l3 = null, cacheLine = null, tlb = null;
-        try { l1 = Module._l1_cache_size_detection ? Module._l1_cache_size_detection(320) : null; } catch(_e) {}
-        try { l2 = Module._l2_cache_size_detection ? Module._l2_cache_size_detection(20480) : null; } catch(_e) {}
-        try { l3 = Module._l3_cache_size_detection ? Module._l3_cache_size_detection(64) : null; } catch(_e) {}
-        try { cacheLine = Module._cache_line_size_detection ? Module._cache_line_size_detection() : null; } catch(_e) {}
-        try { tlb = Module._tlb_size_detection ? Module._tlb_size_detection() : null; } catch(_e) {}
-        // Stride time
-        const strideTimes = await this.measureStrideTimes();
+        let l1 = null, l2 = null, l3 = null, cacheLine = null, tlb = null, tlbProfile = null;
+        if (!stoppedAfter) {
+            try { l1 = Module._l1_cache_size_detection ? Module._l1_cache_size_detection(320) : null; } catch(_e) {}
+            try { l2 = Module._l2_cache_size_detection ? Module._l2_cache_size_detection(20480) : null; } catch(_e) {}
+            try { l3 = Module._l3_cache_size_detection ? Module._l3_cache_size_detection(64) : null; } catch(_e) {}
+            this.configureCacheFlush({ llcKB: l3 ? l3 * 1024 : l2 });
+            try { cacheLine = Module._cache_line_size_detection ? Module._cache_line_size_detection() : null; } catch(_e) {}
+            try { tlbProfile = await this.measureTLBProfile(); } catch(_e) {}
+            if (tlbProfile) {
+                tlb = tlbProfile.l1DtlbEntries;
+            } else {
+                try { tlb = Module._tlb_size_detection ? Module._tlb_size_detection() : null; } catch(_e) {}
+            }
+            await sampleClock('structure');
+            observe('structure', { l1CacheKB: l1 });
+        }
+        // Remaining probes carry no profile evidence; they only run when the test is undecided
+        let strideTimes = null, prefetch = null, mlp = null, branchProfile = null, indirectProfile = null;
+        let codeFootprint = null, fpPipeline = null, denormal = null, libm = null, emitted = null, callOverhead = null;
+        if (!stoppedAfter) {
+            // Stride time
+            strideTimes = await this.measureStrideTimes(undefined, undefined, undefined, { order, seed });
+            try { prefetch = await this.measurePrefetchMatrix(); } catch(_e) {}
+            try { mlp = await this.measureMemoryParallelism(); } catch(_e) {}
+            await sampleClock('memory-probes');
+            try { branchProfile = await this.measureBranchPredictor(); } catch(_e) {}
+            try { indirectProfile = await this.measureIndirectPredictor(); } catch(_e) {}
+            try { codeFootprint = await this.measureCodeFootprint(); } catch(_e) {}
+            try { fpPipeline = await this.measureFPPipeline(); } catch(_e) {}
+            try { denormal = await this.measureDenormalPenalty(); } catch(_e) {}
+            try { libm = await this.measureLibmFingerprint(); } catch(_e) {}
+            if (!nanProbe) {
+                try { nanProbe = await this.probeNaNPropagation(); } catch(_e) {}
+            }
+            if (!relaxedSimd) {
+                try { relaxedSimd = await this.probeRelaxedSIMD(); } catch(_e) {}
+            }
+            try { emitted = await this.measureEmittedKernels(); } catch(_e) {}
+            try { callOverhead = await this.measureCallOverhead(); } catch(_e) {}
+        }
+        await sampleClock('end');
+        const frequency = this.frequencySummary();
 
         const features = {};
 
@@ -810,17 +2343,18 @@ class WASMFingerprint {
         }
 
         // Calculation features
-        features.float_precision = computeResults.float.result;
-        features.integer_opt = computeResults.integer.result;
-        features.vector_comp = computeResults.vector.result;
-        features.branch_pred = computeResults.branch.result;
-        features.simd_supported = simdBenchmark.supported;
-        features.simd_speedup = simdBenchmark.speedup;
-        features.simd_vector_ratio = simdBenchmark.vectorRatio;
-        features.hardware_concurrency = workerProfile.hardwareConcurrency;
-        features.worker_spawn_cap = workerProfile.spawned;
-        features.worker_latency_median = workerProfile.medianLatency;
-        features.worker_latency_mean = workerProfile.meanLatency;
+        features.float_precision = computeResults?.float.result ?? null;
+        features.integer_opt = computeResults?.integer.result ?? null;
+        features.vector_comp = computeResults?.vector.result ?? null;
+        features.branch_pred = computeResults?.branch.result ?? null;
+        features.simd_supported = simdBenchmark ? simdBenchmark.supported : await this.detectSIMDSupport();
+        features.simd_speedup = simdBenchmark?.speedup ?? null;
+        features.simd_vector_ratio = simdBenchmark?.vectorRatio ?? null;
+        features.hardware_concurrency = workerProfile?.hardwareConcurrency ??
+            (typeof navigator !== 'undefined' && navigator.hardwareConcurrency || null);
+        features.worker_spawn_cap = workerProfile?.spawned ?? null;
+        features.worker_latency_median = workerProfile?.medianLatency ?? null;
+        features.worker_latency_mean = workerProfile?.meanLatency ?? null;
 
         // Structure and stride
         features.l1_kb = l1;
@@ -828,7 +2362,76 @@ class WASMFingerprint {
         features.l3_mb = l3;
         features.cache_line = cacheLine;
         features.tlb_entries = tlb;
-        features.stride_ms = strideTimes;
+        features.stlb_entries = tlbProfile?.stlbEntries ?? null;
+        features.tlb_walk_penalty_ns = tlbProfile?.walkPenaltyNs ?? null;
+        features.tlb_huge_pages = tlbProfile ? tlbProfile.hugePagesLikely : null;
+        features.stride_ms = strideTimes?.times ?? null;
+        features.prefetch_matrix = prefetch ? {
+            forward: prefetch.forward,
+            backward: prefetch.backward,
+            stride: prefetch.strides,
+            streams: prefetch.streams,
+            page_cross: prefetch.pageCross
+        } : null;
+        features.prefetch_max_stride = prefetch?.maxStride ?? null;
+        features.prefetch_streams = prefetch?.streamCapacity ?? null;
+        features.mlp_peak = mlp?.peakSpeedup ?? null;
+        features.mlp_saturation_chains = mlp?.saturationChains ?? null;
+        features.mlp_latency_ns = mlp?.latencyNs ?? null;
+        features.mlp_curve = mlp?.curve ?? null;
+        features.branch_mispredict_ns = branchProfile?.mispredictPenaltyNs ?? null;
+        features.branch_history_depth = branchProfile?.historyDepth ?? null;
+        features.branch_loop_depth = branchProfile?.loopDepth ?? null;
+        features.branch_predictable_ns = branchProfile?.predictableNs ?? null;
+        features.indirect_capacity = indirectProfile?.targetCapacity ?? null;
+        features.indirect_history = indirectProfile?.historyReach ?? null;
+        features.indirect_mispredict_ns = indirectProfile?.mispredictPenaltyNs ?? null;
+        features.code_ns_per_kb = codeFootprint?.nsPerKB ?? null;
+        features.code_l1i_knee_kb = codeFootprint?.l1iKneeKB ?? null;
+        features.code_l2_knee_kb = codeFootprint?.l2KneeKB ?? null;
+        features.code_branchy_knee_kb = codeFootprint?.branchyKneeKB ?? null;
+        const f64Pipe = fpPipeline?.f64 || null;
+        features.fp_pipeline = fpPipeline;
+        features.fp_add_ratio = f64Pipe?.add?.ratio ?? null;
+        features.fp_mul_ratio = f64Pipe?.mul?.ratio ?? null;
+        features.fp_div_ratio = f64Pipe?.div?.ratio ?? null;
+        // Latencies relative to add: cycle counts without knowing the clock
+        features.fp_mul_add_latency = f64Pipe?.mul && f64Pipe?.add ? f64Pipe.mul.latencyNs / f64Pipe.add.latencyNs : null;
+        features.fp_div_add_latency = f64Pipe?.div && f64Pipe?.add ? f64Pipe.div.latencyNs / f64Pipe.add.latencyNs : null;
+        features.fp_sqrt_add_latency = f64Pipe?.sqrt && f64Pipe?.add ? f64Pipe.sqrt.latencyNs / f64Pipe.add.latencyNs : null;
+        features.libm_wasm_hash = libm?.wasmHash ?? null;
+        features.libm_js_hash = libm?.jsHash ?? null;
+        features.libm_js_mismatches = libm?.mismatches ?? null;
+        features.nan_hash = nanProbe?.hash ?? null;
+        features.nan_default = nanProbe?.defaultNaN ?? null;
+        features.nan_arch = nanProbe?.arch ?? null;
+        features.nan_min_payload = nanProbe?.minPropagatesPayload ?? null;
+        features.relaxed_simd_mask = relaxedSimd?.supported ? relaxedSimd.mask : null;
+        features.relaxed_simd_arch = relaxedSimd?.arch ?? null;
+        features.relaxed_simd_fma = relaxedSimd?.fma ?? null;
+        if (webgl) {
+            features.webgl_renderer = webgl.fingerprint.basic.renderer ?? null;
+            features.webgl_vendor = webgl.analysis.normalizedVendor ?? null;
+        }
+        features.denormal_penalty_max = denormal?.worstRatio ?? null;
+        features.denormal_add_ratio = denormal?.f64?.add?.ratio ?? null;
+        features.denormal_mul_ratio = denormal?.f64?.mul?.ratio ?? null;
+        features.denormal_muladd_ratio = denormal?.f64?.muladd?.ratio ?? null;
+        features.emitted_add_latency_ns = emitted?.i32AddLatencyNs ?? null;
+        features.emitted_add_throughput_ns = emitted?.i32AddThroughputNs ?? null;
+        features.emitted_fadd_latency_ns = emitted?.f64AddLatencyNs ?? null;
+        features.emitted_load_ns = emitted?.l1LoadNs ?? null;
+        features.emitted_branch_mispredict_ns = emitted?.branchMispredictNs ?? null;
+        features.call_export_ns = callOverhead?.fromJs.direct[1] ?? null;
+        features.call_ccall_ns = callOverhead?.fromJs.ccall[1] ?? null;
+        features.call_wasm_direct_ns = callOverhead?.fromWasm.direct[1] ?? null;
+        features.call_indirect_ns = callOverhead?.fromWasm.indirect[1] ?? null;
+        features.call_import_ns = callOverhead?.fromWasm.import[1] ?? null;
+        features.call_ccall_ratio = callOverhead?.ccallRatio ?? null;
+        features.call_import_ratio = callOverhead?.importRatio ?? null;
+        features.tier_up_ms = tierUp?.timeToTierMs ?? null;
+        features.tier_up_calls = tierUp?.callsToTier ?? null;
+        features.tier_up_speedup = tierUp?.speedup ?? null;
 
         // Derived metrics
         const l1BandKeys = ['32KB','48KB','64KB'];
@@ -838,11 +2441,37 @@ class WASMFingerprint {
         features.mem_ratio_l1_band = pickRatios(l1BandKeys);
         features.mem_ratio_deep = pickRatios(deepKeys);
 
+        // Clock and cycle-normalized timings: *_ns x GHz removes frequency scaling
+        features.cpu_ghz = frequency?.medianGHz ?? null;
+        features.cpu_ghz_min = frequency?.minGHz ?? null;
+        features.cpu_ghz_max = frequency?.maxGHz ?? null;
+        features.cpu_ghz_drift = frequency?.drift ?? null;
+        if (features.cpu_ghz) {
+            for (const key of Object.keys(features)) {
+                if (key.endsWith('_ns') && typeof features[key] === 'number' && isFinite(features[key])) {
+                    features[key.replace(/_ns$/, '_cycles')] = features[key] * features.cpu_ghz;
+                }
+            }
+        }
+
         return {
             features,
             memoryResults,
             computeResults,
-            structure: { l1_kb: l1, l2_kb: l2, l3_mb: l3, cache_line: cacheLine, tlb_entries: tlb },
+            frequency,
+            variant: this.activeVariant,
+            scheduler: { mode: this.scheduler, order, seed, ...this._schedulerStats },
+            sequential: sequential ? {
+                stoppedAfter,
+                best: sequential.test.best,
+                posterior: sequential.test.posterior,
+                logRatio: sequential.test.logRatio,
+                ranking: sequential.test.ranking,
+                observed: sequential.test.observed
+            } : null,
+            probeEstimates: this.probeEstimates,
+            tier: { tierUp, stride: strideTimes?.tier ?? null, kernels: Object.fromEntries(this._tierState) },
+            structure: { l1_kb: l1, l2_kb: l2, l3_mb: l3, cache_line: cacheLine, tlb_entries: tlb, tlb: tlbProfile },
             workerProfile,
             hash: this.calculateHash(features)
         };
@@ -1028,6 +2657,34 @@ class WASMFingerprint {
             }
         }
 
+        // Without memory timings (fast mode) the deterministic ISA signals pick the family;
+        // an Apple WebGL renderer on ARM semantics is specific enough to name it. A GPU vendor
+        // that ships with the detected ISA scores the same on every path, so relaxed SIMD +
+        // matching GPU (+ agreeing NaN) clears fastConfidenceThreshold; a single ISA signal
+        // without relaxed SIMD stays below it and escalates
+        const isaArch = f.relaxed_simd_arch === 'arm' || f.relaxed_simd_arch === 'x86' ? f.relaxed_simd_arch
+            : (f.nan_arch === 'arm' || f.nan_arch === 'x86' ? f.nan_arch : null);
+        if (family === 'Unknown' && isaArch) {
+            const ISA_GPU_VENDORS = { arm: ['apple', 'qualcomm', 'arm'], x86: ['intel', 'amd', 'nvidia'] };
+            const gpuMatches = ISA_GPU_VENDORS[isaArch].includes(f.webgl_vendor);
+            if (isaArch === 'arm' && f.webgl_vendor === 'apple') {
+                family = 'Apple';
+                evidence.push('ARM semantics with Apple GPU renderer');
+            } else if (isaArch === 'arm') {
+                family = 'AMD/ARM-like'; evidence.push('ARM semantics without timing data');
+            } else {
+                family = 'Intel/AMD-like'; evidence.push('x86 semantics without timing data');
+            }
+            if (gpuMatches) {
+                confidence += 10;
+                if (family !== 'Apple') evidence.push(`${f.webgl_vendor} GPU consistent with ${isaArch}`);
+            }
+            if (logicalCores && logicalCores >= 12 && !tier) {
+                tier = family === 'Apple' ? 'Pro/Max' : 'Desktop-High';
+                evidence.push(`Concurrent Cores≈${logicalCores}`);
+            }
+        }
+
         // Prefetcher efficiency bonus: infer using stride_ms (small/large)
         const stride = f.stride_ms || {};
         const t64 = typeof stride[64] === 'number' ? stride[64] : null;
@@ -1046,6 +2703,49 @@ class WASMFingerprint {
             evidence.push('WASM SIMD extension detected');
         }
 
+        // Relaxed SIMD results are the host's native semantics: a deterministic ISA signal
+        if (f.relaxed_simd_arch === 'arm' || f.relaxed_simd_arch === 'x86') {
+            evidence.push(`Relaxed SIMD semantics: ${f.relaxed_simd_arch}${f.relaxed_simd_fma ? ' + FMA' : ''}`);
+            const consistent = f.relaxed_simd_arch === 'arm'
+                ? (family === 'Apple' || family === 'AMD/ARM-like')
+                : family === 'Intel/AMD-like';
+            if (consistent) {
+                confidence = Math.min(95, confidence + 10);
+            } else if (f.relaxed_simd_arch === 'x86' && family === 'Apple') {
+                // Native Apple Silicon cannot produce x86 semantics (only an x86 browser under Rosetta)
+                confidence = Math.max(0, confidence - 15);
+                evidence.push('Relaxed SIMD x86 semantics contradict Apple guess');
+            }
+        }
+
+        // Default NaN sign from 0 * inf, also hardware-native and timing-free. It comes from the
+        // scalar FPU rather than the SIMD unit, so agreement with relaxed SIMD corroborates it;
+        // a disagreement means one of them is translated or emulated and neither is trusted
+        if (f.nan_arch === 'arm' || f.nan_arch === 'x86') {
+            evidence.push(`Default NaN ${f.nan_default}: ${f.nan_arch}`);
+            const relaxedArch = f.relaxed_simd_arch === 'arm' || f.relaxed_simd_arch === 'x86' ? f.relaxed_simd_arch : null;
+            const consistent = f.nan_arch === 'arm'
+                ? (family === 'Apple' || family === 'AMD/ARM-like')
+                : family === 'Intel/AMD-like';
+            if (relaxedArch && relaxedArch !== f.nan_arch) {
+                confidence = Math.max(0, confidence - 10);
+                evidence.push(`Default NaN (${f.nan_arch}) contradicts relaxed SIMD (${relaxedArch})`);
+            } else if (consistent) {
+                confidence = Math.min(95, confidence + 5);
+            }
+        }
+
+        // FP add latency/throughput ratio ~ latency cycles x FP ports: ~6 on 2-port x86 cores,
+        // >=9 on 4-port designs (Apple P-cores, Neoverse V-class)
+        const fpAddRatio = typeof f.fp_add_ratio === 'number' && isFinite(f.fp_add_ratio) ? f.fp_add_ratio : null;
+        const fpPorts = fpAddRatio === null ? null : (fpAddRatio >= 9 ? 4 : 2);
+        if (fpPorts !== null) {
+            evidence.push(`FP add latency/throughput=${fpAddRatio.toFixed(1)} (~${fpPorts} FP pipes)`);
+            if ((fpPorts === 4 && family === 'Apple') || (fpPorts === 2 && family === 'Intel/AMD-like')) {
+                confidence = Math.min(95, confidence + 3);
+            }
+        }
+
         if (workerCap && workerCap >= 12) {
             evidence.push(`Worker concurrency limit≈${workerCap}`);
             if (!logicalCores && workerCap >= 12) {
@@ -1053,7 +2753,7 @@ class WASMFingerprint {
             }
         }
 
-        return { family, generation, tier, confidence, evidence, l1kb, l2kb, l3mb, l1Band, deepBand, overall };
+        return { family, generation, tier, confidence, evidence, l1kb, l2kb, l3mb, l1Band, deepBand, overall, fpPorts };
     }
 
     _safeOverallRatio(memoryResults) {
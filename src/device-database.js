@@ -3,6 +3,9 @@
  * Feature database and recognition algorithm for precise device model identification
  */
 
+// Sequential test features that come from timing probes (see updateSequentialTest)
+const SEQUENTIAL_TIMING_FEATURES = ['memoryRatio', 'l1CacheKB'];
+
 class DeviceSignatureDatabase {
     constructor() {
         this.deviceProfiles = this.initializeDeviceProfiles();
@@ -1193,6 +1196,127 @@ class DeviceSignatureDatabase {
 
         return similar.sort((a, b) => b.score - a.score);
     }
+
+    /**
+     * Sequential identification over the device profiles (Wald SPRT, multi-hypothesis form)
+     * Create the test once, feed observations as probes finish, and stop probing once
+     * `decided` is set: the top profile's posterior reaches `confidence` and its log
+     * likelihood ratio against the runner-up crosses ln((1 - beta) / alpha), alpha = beta = 1 - confidence.
+     * The profiles are a closed list, so an "Other" hypothesis (any device not in the
+     * database, prior equal to all profiles combined) competes with them; the test never
+     * decides for "Other", and only decides once a timing feature has been observed.
+     */
+    createSequentialTest(confidence = 0.9) {
+        const candidates = [];
+        for (const [brand, devices] of Object.entries(this.deviceProfiles)) {
+            for (const [deviceName, profile] of Object.entries(devices)) {
+                candidates.push({ brand, deviceName, profile, logLikelihood: 0 });
+            }
+        }
+        if (candidates.length) {
+            candidates.push({ brand: 'Other', deviceName: '(not in database)', profile: null, other: true,
+                logLikelihood: Math.log(candidates.length) });
+        }
+        return {
+            confidence: Math.min(0.999, Math.max(0.5, confidence)),
+            candidates,
+            observed: {},
+            steps: 0,
+            decided: false,
+            best: null,
+            posterior: candidates.length ? 1 / candidates.length : 0,
+            logRatio: 0
+        };
+    }
+
+    /**
+     * Add observations ({ cores, arch, webglRenderer, memoryRatio, l1CacheKB }) to a sequential
+     * test. Features already observed and null values are ignored.
+     */
+    updateSequentialTest(test, observations = {}) {
+        for (const [feature, value] of Object.entries(observations)) {
+            if (value === null || value === undefined || feature in test.observed) continue;
+            test.observed[feature] = value;
+            for (const candidate of test.candidates) {
+                candidate.logLikelihood += candidate.other
+                    ? this.openWorldLogLikelihood(feature)
+                    : this.featureLogLikelihood(candidate.profile, feature, value);
+            }
+        }
+        test.steps++;
+        if (!test.candidates.length) return test;
+
+        const ranked = [...test.candidates].sort((a, b) => b.logLikelihood - a.logLikelihood);
+        const top = ranked[0].logLikelihood;
+        const partition = ranked.reduce((sum, c) => sum + Math.exp(c.logLikelihood - top), 0);
+        const alpha = 1 - test.confidence;
+        test.posterior = 1 / partition;
+        test.logRatio = ranked.length > 1 ? top - ranked[1].logLikelihood : Infinity;
+        test.best = `${ranked[0].brand} ${ranked[0].deviceName}`;
+        test.ranking = ranked.slice(0, 3).map(c => ({
+            device: `${c.brand} ${c.deviceName}`,
+            posterior: Math.exp(c.logLikelihood - top) / partition
+        }));
+        // Timing-free features alone (cores, ISA, GPU) are shared by many unlisted devices
+        const timingObserved = SEQUENTIAL_TIMING_FEATURES.some(feature => feature in test.observed);
+        test.decided = timingObserved && !ranked[0].other &&
+            test.posterior >= test.confidence && test.logRatio >= Math.log((1 - alpha) / alpha);
+        return test;
+    }
+
+    /**
+     * Log-likelihood of one observation for a device outside the database: the chance that
+     * an arbitrary device shows a value a matching profile would predict exactly
+     */
+    openWorldLogLikelihood(feature) {
+        switch (feature) {
+            case 'cores': return Math.log(0.25);        // a handful of common core counts
+            case 'arch': return Math.log(0.5);          // x86 or ARM
+            case 'webglRenderer': return Math.log(0.1); // same as a same-vendor renderer mismatch
+            case 'memoryRatio':
+            case 'l1CacheKB': return -1;                // broad prior over the timing ranges
+            default: return 0;
+        }
+    }
+
+    /**
+     * Log-likelihood of one observation under a profile. Values inside the profile's range
+     * score 0 and fall off as a Gaussian in units of the feature's measurement noise outside
+     * it; a profile that does not constrain the feature gets a flat -0.5 (one sigma).
+     */
+    featureLogLikelihood(profile, feature, value) {
+        const cpu = profile?.cpu || {};
+        const soft = (range, sigma) => {
+            if (!range) return -0.5;
+            const d = this._distanceToRange(value, range.min, range.max);
+            return -0.5 * (d / sigma) * (d / sigma);
+        };
+        switch (feature) {
+            case 'cores':
+                if (!cpu.cores) return -1;
+                return cpu.cores.total === value ? 0 : -3;
+            case 'arch': {
+                const arch = (cpu.architecture || '').toLowerCase();
+                const expected = arch.includes('apple') || arch.includes('arm') ? 'arm'
+                    : (arch.includes('intel') || arch.includes('amd') ? 'x86' : null);
+                if (!expected) return -0.5;
+                return expected === value ? 0 : Math.log(0.01);
+            }
+            case 'webglRenderer': {
+                const webgl = profile?.gpu?.webgl;
+                if (!webgl) return -1.2;
+                if (webgl.renderer && webgl.renderer.test(value)) return 0;
+                return this._normalizeVendorToken(webgl.vendor) === this._normalizeVendorToken(value)
+                    ? Math.log(0.1) : Math.log(0.02);
+            }
+            case 'memoryRatio':
+                return soft(cpu.memoryRatio, 0.25);
+            case 'l1CacheKB':
+                return soft(cpu.l1CacheKB, 16);
+            default:
+                return 0;
+        }
+    }
 }
 
 // Export module
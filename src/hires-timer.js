@@ -0,0 +1,152 @@
+/**
+ * Shared-memory counter timer
+ * Browsers coarsen performance.now() to 5µs–1ms. When the page is cross-origin isolated,
+ * a worker spinning on a SharedArrayBuffer word gives a much finer clock: the main thread
+ * reads the counter and converts ticks to milliseconds using a rate calibrated against
+ * performance.now().
+ */
+
+class SharedCounterTimer {
+    constructor(options = {}) {
+        this.calibrationMs = options.calibrationMs ?? 60;
+        this.startupTimeoutMs = options.startupTimeoutMs ?? 500;
+        this.available = false;
+        this.failureReason = null;
+        this.ticksPerMs = null;
+        this.resolutionMs = null;
+        this._worker = null;
+        this._workerUrl = null;
+        this._counter = null;   // Float64Array[1]: tick count written by the worker
+        this._control = null;   // Int32Array[1]: non-zero asks the worker to stop
+        this._originTicks = 0;
+        this._originMs = 0;
+    }
+
+    static isSupported() {
+        return typeof SharedArrayBuffer === 'function' &&
+            typeof Atomics === 'object' &&
+            typeof Worker === 'function' &&
+            typeof crossOriginIsolated !== 'undefined' &&
+            crossOriginIsolated === true;
+    }
+
+    async start() {
+        if (this.available) return true;
+        if (!SharedCounterTimer.isSupported()) {
+            this.failureReason = 'SharedArrayBuffer unavailable (page is not cross-origin isolated)';
+            return false;
+        }
+
+        // Counter is a float64 so it never wraps; aligned 8-byte stores are not torn on the
+        // 64-bit platforms that can grant cross-origin isolation.
+        const sab = new SharedArrayBuffer(16);
+        this._counter = new Float64Array(sab, 0, 1);
+        this._control = new Int32Array(sab, 8, 1);
+
+        const workerScript = `self.onmessage = function(evt) {
+    var counter = new Float64Array(evt.data.sab, 0, 1);
+    var control = new Int32Array(evt.data.sab, 8, 1);
+    var n = 0;
+    self.postMessage({ type: 'running' });
+    while (Atomics.load(control, 0) === 0) {
+        for (var i = 0; i < 1024; i++) {
+            counter[0] = ++n;
+        }
+    }
+    try { self.close(); } catch (e) {}
+};`;
+
+        try {
+            const blob = new Blob([workerScript], { type: 'application/javascript' });
+            this._workerUrl = URL.createObjectURL(blob);
+            this._worker = new Worker(this._workerUrl, { name: 'shared-counter-timer' });
+
+            await new Promise((resolve, reject) => {
+                const timeout = setTimeout(() => reject(new Error('counter worker startup timeout')), this.startupTimeoutMs);
+                this._worker.onmessage = (event) => {
+                    if (event?.data?.type === 'running') {
+                        clearTimeout(timeout);
+                        resolve();
+                    }
+                };
+                this._worker.onerror = (err) => {
+                    clearTimeout(timeout);
+                    reject(err instanceof Error ? err : new Error(err?.message || String(err)));
+                };
+                this._worker.postMessage({ sab });
+            });
+
+            // Wait until the counter actually moves (worker may be scheduled late)
+            const deadline = performance.now() + this.startupTimeoutMs;
+            while (this._counter[0] === 0) {
+                if (performance.now() > deadline) throw new Error('counter worker never ticked');
+                await new Promise(res => setTimeout(res, 1));
+            }
+
+            await this.calibrate();
+            this.available = this.ticksPerMs > 0;
+            if (!this.available) this.failureReason = 'counter calibration failed';
+        } catch (err) {
+            this.failureReason = err?.message || String(err);
+            this.stop();
+        }
+
+        return this.available;
+    }
+
+    // Calibrate tick rate against performance.now(), aligning both ends to clock edges
+    async calibrate() {
+        const waitEdge = () => {
+            const t = performance.now();
+            let e;
+            do { e = performance.now(); } while (e === t);
+            return e;
+        };
+
+        const t0 = waitEdge();
+        const c0 = this._counter[0];
+        await new Promise(res => setTimeout(res, this.calibrationMs));
+        const t1 = waitEdge();
+        const c1 = this._counter[0];
+
+        const elapsed = t1 - t0;
+        this.ticksPerMs = elapsed > 0 ? (c1 - c0) / elapsed : null;
+        this.resolutionMs = this.ticksPerMs ? 1 / this.ticksPerMs : null;
+        this._originTicks = c1;
+        this._originMs = t1;
+        return this.ticksPerMs;
+    }
+
+    ticks() {
+        return this._counter ? this._counter[0] : 0;
+    }
+
+    // Milliseconds on the performance.now() time base, with sub-microsecond resolution
+    now() {
+        if (!this.available) return performance.now();
+        return this._originMs + (this._counter[0] - this._originTicks) / this.ticksPerMs;
+    }
+
+    stop() {
+        if (this._control) {
+            try { Atomics.store(this._control, 0, 1); } catch (_e) {}
+        }
+        if (this._worker) {
+            try { this._worker.terminate(); } catch (_e) {}
+        }
+        if (this._workerUrl) {
+            URL.revokeObjectURL(this._workerUrl);
+        }
+        this._worker = null;
+        this._workerUrl = null;
+        this.available = false;
+    }
+}
+
+if (typeof window !== 'undefined') {
+    window.SharedCounterTimer = SharedCounterTimer;
+}
+
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = SharedCounterTimer;
+}
@@ -0,0 +1,255 @@
+/**
+ * Runtime WASM kernel emitter
+ * clang/emcc are free to rewrite C probes (fold add chains, vectorize loads, turn branches
+ * into selects). This emitter writes the bytecode directly, so a kernel executes exactly the
+ * instruction sequence we ask for. Shape parameters (chain length, unroll factor, stride) are
+ * baked in as constants; modules are compiled once per parameter set and cached.
+ *
+ * Every kernel exports `run(iterations, arg)`; load kernels also export `memory`.
+ */
+
+const WASM_OP = {
+    block: 0x02, loop: 0x03, if: 0x04, else: 0x05, end: 0x0b, br: 0x0c, br_if: 0x0d,
+    local_get: 0x20, local_set: 0x21,
+    i32_load: 0x28, i32_const: 0x41,
+    i32_eqz: 0x45, i32_add: 0x6a, i32_sub: 0x6b, i32_mul: 0x6c, i32_and: 0x71, i32_xor: 0x73,
+    i32_shr_u: 0x76, f64_add: 0xa0, f64_convert_i32_s: 0xb7
+};
+const WASM_TYPE = { i32: 0x7f, f64: 0x7c, void: 0x40 };
+
+// Byte buffer with the LEB128 encodings used by the binary format
+class WasmBytes {
+    constructor() {
+        this.bytes = [];
+    }
+
+    byte(...values) {
+        for (const v of values) this.bytes.push(v & 0xff);
+        return this;
+    }
+
+    u32(value) {
+        let v = value >>> 0;
+        do {
+            let b = v & 0x7f;
+            v >>>= 7;
+            if (v !== 0) b |= 0x80;
+            this.bytes.push(b);
+        } while (v !== 0);
+        return this;
+    }
+
+    s32(value) {
+        let v = value | 0;
+        for (;;) {
+            const b = v & 0x7f;
+            v >>= 7;
+            if ((v === 0 && (b & 0x40) === 0) || (v === -1 && (b & 0x40) !== 0)) {
+                this.bytes.push(b);
+                return this;
+            }
+            this.bytes.push(b | 0x80);
+        }
+    }
+
+    name(str) {
+        const encoded = Array.from(str, ch => ch.charCodeAt(0));
+        this.u32(encoded.length);
+        this.bytes.push(...encoded);
+        return this;
+    }
+
+    append(other) {
+        this.bytes.push(...(other.bytes || other));
+        return this;
+    }
+
+    // Length-prefixed section
+    section(id, body) {
+        this.byte(id).u32(body.bytes.length).append(body);
+        return this;
+    }
+}
+
+class WasmKernelEmitter {
+    constructor() {
+        this._cache = new Map();   // key -> Promise<instance exports>
+        this.compiledCount = 0;
+    }
+
+    static isSupported() {
+        return typeof WebAssembly === 'object' && typeof WebAssembly.instantiate === 'function';
+    }
+
+    // Compile (or fetch from cache) a kernel. kind: 'addChain' | 'loads' | 'branchLadder'
+    getKernel(kind, params = {}) {
+        const key = `${kind}:${JSON.stringify(params, Object.keys(params).sort())}`;
+        if (this._cache.has(key)) {
+            return this._cache.get(key);
+        }
+        const bytes = this.emit(kind, params);
+        const promise = WebAssembly.instantiate(bytes, {}).then(({ instance }) => {
+            this.compiledCount++;
+            return instance.exports;
+        });
+        // Do not cache failures; the next call gets a fresh attempt
+        promise.catch(() => this._cache.delete(key));
+        this._cache.set(key, promise);
+        return promise;
+    }
+
+    emit(kind, params = {}) {
+        switch (kind) {
+            case 'addChain': return this.emitAddChain(params);
+            case 'loads': return this.emitLoads(params);
+            case 'branchLadder': return this.emitBranchLadder(params);
+            default: throw new Error(`unknown emitted kernel: ${kind}`);
+        }
+    }
+
+    // Dependent adds: `chains` independent accumulators, each advanced `length` times per
+    // iteration by a loop-invariant (non-constant) addend, so nothing can be folded.
+    // chains=1 measures add latency, chains>=8 measures throughput. type: 'i32' | 'f64'.
+    emitAddChain({ length = 64, chains = 1, type = 'i32' } = {}) {
+        chains = Math.max(1, Math.min(64, chains | 0));  // keeps local indices single-byte
+        const isF64 = type === 'f64';
+        const valType = isF64 ? WASM_TYPE.f64 : WASM_TYPE.i32;
+        const addOp = isF64 ? WASM_OP.f64_add : WASM_OP.i32_add;
+        // locals: 0 iterations, 1 arg, 2 addend, 3.. accumulators
+        const addend = 2, acc0 = 3;
+
+        const body = new WasmBytes();
+        body.byte(WASM_OP.local_get, 1);
+        if (isF64) body.byte(WASM_OP.f64_convert_i32_s);
+        body.byte(WASM_OP.local_set, addend);
+        for (let c = 0; c < chains; c++) {
+            body.byte(WASM_OP.local_get, 1);
+            if (isF64) body.byte(WASM_OP.f64_convert_i32_s);
+            body.byte(WASM_OP.local_set, acc0 + c);
+        }
+        this._countedLoop(body, 0, loop => {
+            for (let i = 0; i < length; i++) {
+                for (let c = 0; c < chains; c++) {
+                    loop.byte(WASM_OP.local_get, acc0 + c, WASM_OP.local_get, addend, addOp, WASM_OP.local_set, acc0 + c);
+                }
+            }
+        });
+        body.byte(WASM_OP.local_get, acc0);
+        for (let c = 1; c < chains; c++) {
+            body.byte(WASM_OP.local_get, acc0 + c, addOp);
+        }
+
+        return this._module({
+            result: valType,
+            locals: [[1, valType], [chains, valType]],
+            body
+        });
+    }
+
+    // Unrolled i32 loads at constant offsets base + k*stride; base advances by unroll*stride
+    // and wraps inside a power-of-two buffer (sizeBytes). Memory is exported for the caller
+    // to fill; loads are summed so none of them is dead.
+    emitLoads({ unroll = 16, stride = 64, sizeBytes = 1 << 20 } = {}) {
+        const pages = Math.max(1, Math.ceil((sizeBytes + unroll * stride) / 65536));
+        const mask = (1 << Math.ceil(Math.log2(Math.max(sizeBytes, 4)))) - 1;
+        // locals: 0 iterations, 1 arg, 2 base, 3 sum
+        const base = 2, sum = 3;
+
+        const body = new WasmBytes();
+        this._countedLoop(body, 0, loop => {
+            for (let k = 0; k < unroll; k++) {
+                loop.byte(WASM_OP.local_get, base, WASM_OP.i32_load, 2).u32(k * stride);
+                loop.byte(WASM_OP.local_get, sum, WASM_OP.i32_add, WASM_OP.local_set, sum);
+            }
+            loop.byte(WASM_OP.local_get, base, WASM_OP.i32_const).s32(unroll * stride);
+            loop.byte(WASM_OP.i32_add, WASM_OP.i32_const).s32(mask & ~3);
+            loop.byte(WASM_OP.i32_and, WASM_OP.local_set, base);
+        });
+        body.byte(WASM_OP.local_get, sum);
+
+        return this._module({
+            result: WASM_TYPE.i32,
+            locals: [[2, WASM_TYPE.i32]],
+            body,
+            memoryPages: pages
+        });
+    }
+
+    // `rungs` if/else rungs, each testing one bit of a per-iteration value. The value is
+    // `arg` when mode is 'fixed' (fully predictable) or advanced by an LCG every iteration
+    // when mode is 'random' (each rung mispredicts half the time).
+    emitBranchLadder({ rungs = 16, mode = 'fixed' } = {}) {
+        // locals: 0 iterations, 1 arg (bits), 2 acc
+        const bits = 1, acc = 2;
+
+        const body = new WasmBytes();
+        this._countedLoop(body, 0, loop => {
+            if (mode === 'random') {
+                loop.byte(WASM_OP.local_get, bits, WASM_OP.i32_const).s32(1664525);
+                loop.byte(WASM_OP.i32_mul, WASM_OP.i32_const).s32(1013904223);
+                loop.byte(WASM_OP.i32_add, WASM_OP.local_set, bits);
+            }
+            for (let r = 0; r < rungs; r++) {
+                // Test high bits first: the LCG's low bits have short periods
+                const bit = 31 - (r % 24);
+                loop.byte(WASM_OP.local_get, bits, WASM_OP.i32_const).s32(bit);
+                loop.byte(WASM_OP.i32_shr_u, WASM_OP.i32_const).s32(1);
+                loop.byte(WASM_OP.i32_and, WASM_OP.if, WASM_TYPE.void);
+                loop.byte(WASM_OP.local_get, acc, WASM_OP.i32_const).s32(0x9e3779b9 + r);
+                loop.byte(WASM_OP.i32_add, WASM_OP.local_set, acc);
+                loop.byte(WASM_OP.else);
+                loop.byte(WASM_OP.local_get, acc, WASM_OP.i32_const).s32(0x7f4a7c15 ^ r);
+                loop.byte(WASM_OP.i32_xor, WASM_OP.local_set, acc);
+                loop.byte(WASM_OP.end);
+            }
+        });
+        body.byte(WASM_OP.local_get, acc);
+
+        return this._module({
+            result: WASM_TYPE.i32,
+            locals: [[1, WASM_TYPE.i32]],
+            body
+        });
+    }
+
+    // `for (; iterations != 0; iterations--) { emitBody }` on local `counter`
+    _countedLoop(out, counter, emitBody) {
+        out.byte(WASM_OP.block, WASM_TYPE.void, WASM_OP.loop, WASM_TYPE.void);
+        out.byte(WASM_OP.local_get, counter, WASM_OP.i32_eqz, WASM_OP.br_if, 1);
+        emitBody(out);
+        out.byte(WASM_OP.local_get, counter, WASM_OP.i32_const, 1, WASM_OP.i32_sub, WASM_OP.local_set, counter);
+        out.byte(WASM_OP.br, 0, WASM_OP.end, WASM_OP.end);
+    }
+
+    // Single-function module: run(i32 iterations, i32 arg) -> result
+    _module({ result, locals, body, memoryPages = 0 }) {
+        const out = new WasmBytes();
+        out.byte(0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00);
+
+        out.section(1, new WasmBytes().u32(1).byte(0x60).u32(2).byte(WASM_TYPE.i32, WASM_TYPE.i32).u32(1).byte(result));
+        out.section(3, new WasmBytes().u32(1).u32(0));
+        if (memoryPages > 0) {
+            out.section(5, new WasmBytes().u32(1).byte(0x00).u32(memoryPages));
+        }
+
+        const exports = new WasmBytes().u32(memoryPages > 0 ? 2 : 1);
+        exports.name('run').byte(0x00).u32(0);
+        if (memoryPages > 0) exports.name('memory').byte(0x02).u32(0);
+        out.section(7, exports);
+
+        const fn = new WasmBytes().u32(locals.length);
+        for (const [count, type] of locals) fn.u32(count).byte(type);
+        fn.append(body).byte(WASM_OP.end);
+        out.section(10, new WasmBytes().u32(1).u32(fn.bytes.length).append(fn));
+
+        return new Uint8Array(out.bytes);
+    }
+}
+
+if (typeof window !== 'undefined') {
+    window.WasmKernelEmitter = WasmKernelEmitter;
+}
+
+if (typeof module !== 'undefined' && module.exports) {
+    module.exports = WasmKernelEmitter;
+}
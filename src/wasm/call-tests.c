@@ -0,0 +1,152 @@
+#include "probe-platform.h"
+#include "probe-clock.h"
+
+// Call-overhead kernels
+// call_noopN are JS->WASM targets timed from the JS side (direct export, bind, ccall, cwrap).
+// call_overhead_profile times the in-module paths: WASM->WASM direct calls, call_indirect
+// through an opaque function pointer, and WASM->JS imports (EM_JS), each with 0/1/2/4/8
+// i32 arguments. Every call's result feeds the next call's first argument, so no call can
+// be dropped, hoisted or overlapped with the next one. Without a JS host (WASI, native)
+// the import path reports -1.
+#define CALL_PATH_DIRECT   0
+#define CALL_PATH_INDIRECT 1
+#define CALL_PATH_IMPORT   2
+#define CALL_PATH_COUNT    3
+#define CALL_ARG_VARIANTS  5   // 0, 1, 2, 4, 8 arguments
+
+// JS->WASM targets
+EMSCRIPTEN_KEEPALIVE int call_noop0(void) { return 0; }
+EMSCRIPTEN_KEEPALIVE int call_noop1(int a) { return a; }
+EMSCRIPTEN_KEEPALIVE int call_noop2(int a, int b) { return a ^ b; }
+EMSCRIPTEN_KEEPALIVE int call_noop4(int a, int b, int c, int d) { return a ^ b ^ c ^ d; }
+EMSCRIPTEN_KEEPALIVE int call_noop8(int a, int b, int c, int d, int e, int f, int g, int h) {
+    return a ^ b ^ c ^ d ^ e ^ f ^ g ^ h;
+}
+
+// WASM->WASM targets; the empty asm keeps the optimizer from treating them as pure
+__attribute__((noinline)) static int callee0(void) { __asm__ volatile(""); return 1; }
+__attribute__((noinline)) static int callee1(int a) { __asm__ volatile(""); return a + 1; }
+__attribute__((noinline)) static int callee2(int a, int b) { __asm__ volatile(""); return a + b; }
+__attribute__((noinline)) static int callee4(int a, int b, int c, int d) {
+    __asm__ volatile("");
+    return a + b + c + d;
+}
+__attribute__((noinline)) static int callee8(int a, int b, int c, int d, int e, int f, int g, int h) {
+    __asm__ volatile("");
+    return a + b + c + d + e + f + g + h;
+}
+
+// Read through volatiles so the targets stay unknown and the calls compile to call_indirect
+static int (*volatile indirect0)(void) = callee0;
+static int (*volatile indirect1)(int) = callee1;
+static int (*volatile indirect2)(int, int) = callee2;
+static int (*volatile indirect4)(int, int, int, int) = callee4;
+static int (*volatile indirect8)(int, int, int, int, int, int, int, int) = callee8;
+
+#if PROBE_HAS_JS
+// WASM->JS imports
+EM_JS(int, call_import0, (), { return 1; });
+EM_JS(int, call_import1, (int a), { return a + 1; });
+EM_JS(int, call_import2, (int a, int b), { return a + b; });
+EM_JS(int, call_import4, (int a, int b, int c, int d), { return a + b + c + d; });
+EM_JS(int, call_import8, (int a, int b, int c, int d, int e, int f, int g, int h), {
+    return a + b + c + d + e + f + g + h;
+});
+#endif
+
+static volatile int call_sink;
+
+#define CALL_LOOP(expr) do {                        \
+    double start = probe_timer_start();             \
+    for (int i = 0; i < calls; i++) { acc = expr; } \
+    elapsed = probe_timer_elapsed_ms(start);        \
+} while (0)
+
+// Milliseconds for `calls` calls along one path with arg_variant 0..4 (0/1/2/4/8 arguments)
+static double call_path_time(int path, int arg_variant, int calls) {
+    int acc = calls;
+    double elapsed = 0.0;
+
+    if (path == CALL_PATH_DIRECT) {
+        switch (arg_variant) {
+            case 0: CALL_LOOP(acc + callee0()); break;
+            case 1: CALL_LOOP(callee1(acc)); break;
+            case 2: CALL_LOOP(callee2(acc, i)); break;
+            case 3: CALL_LOOP(callee4(acc, i, 2, 3)); break;
+            default: CALL_LOOP(callee8(acc, i, 2, 3, 4, 5, 6, 7)); break;
+        }
+    } else if (path == CALL_PATH_INDIRECT) {
+        int (*f0)(void) = indirect0;
+        int (*f1)(int) = indirect1;
+        int (*f2)(int, int) = indirect2;
+        int (*f4)(int, int, int, int) = indirect4;
+        int (*f8)(int, int, int, int, int, int, int, int) = indirect8;
+        switch (arg_variant) {
+            case 0: CALL_LOOP(acc + f0()); break;
+            case 1: CALL_LOOP(f1(acc)); break;
+            case 2: CALL_LOOP(f2(acc, i)); break;
+            case 3: CALL_LOOP(f4(acc, i, 2, 3)); break;
+            default: CALL_LOOP(f8(acc, i, 2, 3, 4, 5, 6, 7)); break;
+        }
+    } else {
+#if PROBE_HAS_JS
+        switch (arg_variant) {
+            case 0: CALL_LOOP(acc + call_import0()); break;
+            case 1: CALL_LOOP(call_import1(acc)); break;
+            case 2: CALL_LOOP(call_import2(acc, i)); break;
+            case 3: CALL_LOOP(call_import4(acc, i, 2, 3)); break;
+            default: CALL_LOOP(call_import8(acc, i, 2, 3, 4, 5, 6, 7)); break;
+        }
+#endif
+    }
+    call_sink = acc;
+    return elapsed;
+}
+
+// Same loop with the call replaced by a register-only step: the per-iteration floor
+static double call_baseline_time(int calls) {
+    int acc = calls;
+    double elapsed = 0.0;
+    CALL_LOOP((acc ^ i) + 1; __asm__ volatile("" : "+r"(acc)));
+    call_sink = acc;
+    return elapsed;
+}
+
+// Best of three (after a warm-up pass) ns per call for every path x argument count, loop
+// floor subtracted:
+//   out[path * CALL_ARG_VARIANTS + k]  path 0 direct, 1 indirect, 2 import; k: 0/1/2/4/8 args
+//   out[CALL_PATH_COUNT * CALL_ARG_VARIANTS]  loop floor, ns per iteration
+// Returns the 0-argument direct call cost.
+EMSCRIPTEN_KEEPALIVE
+double call_overhead_profile(double* out, int calls) {
+    if (calls < 1000) calls = 1000;
+
+    double floor_ms = 1e30;
+    call_baseline_time(calls / 10);
+    for (int r = 0; r < 3; r++) {
+        double t = call_baseline_time(calls);
+        if (t < floor_ms) floor_ms = t;
+    }
+    double floor_ns = floor_ms * 1e6 / calls;
+
+    for (int path = 0; path < CALL_PATH_COUNT; path++) {
+        for (int k = 0; k < CALL_ARG_VARIANTS; k++) {
+            if (path == CALL_PATH_IMPORT && !PROBE_HAS_JS) {
+                out[path * CALL_ARG_VARIANTS + k] = -1.0;
+                continue;
+            }
+            // JS imports cost ~10x more per call; keep their runs comparable in length
+            int n = path == CALL_PATH_IMPORT ? calls / 4 : calls;
+            double best = 1e30;
+            call_path_time(path, k, n / 10);
+            for (int r = 0; r < 3; r++) {
+                double t = call_path_time(path, k, n);
+                if (t < best) best = t;
+            }
+            double ns = best * 1e6 / n - floor_ns;
+            out[path * CALL_ARG_VARIANTS + k] = ns > 0 ? ns : 0.0;
+        }
+    }
+    out[CALL_PATH_COUNT * CALL_ARG_VARIANTS] = floor_ns;
+    return out[0];
+}
@@ -1,6 +1,9 @@
-#include <emscripten.h>
+#include "probe-platform.h"
 #include <math.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include "probe-clock.h"
+#include "indirect-targets.h"
 
 // Fixed floating-point precision test
 EMSCRIPTEN_KEEPALIVE
@@ -39,6 +42,109 @@ double transcendental_test(double input, int iterations) {
     return result;
 }
 
+// Table-driven libm fingerprint
+// Evaluates sin/cos/tan/exp/log/pow/atan2/cbrt over a fixed table of hard-to-round
+// inputs (huge and near-multiple-of-pi/2 trig arguments, exp near overflow and underflow,
+// log near 1, pow with bases near 1 and large exponents...). The inputs are written out so
+// JS can run Math.* over the same table; both sides hash the result bits the same way.
+#define LIBM_FN_COUNT 8  // entry i uses function i % 8: sin cos tan exp log pow atan2 cbrt
+
+static unsigned int libm_seed;
+
+static unsigned int libm_next(void) {
+    libm_seed = libm_seed * 1664525u + 1013904223u;
+    return libm_seed;
+}
+
+// Uniform double in [0, 1) with a full 53-bit mantissa
+static double libm_uniform(void) {
+    unsigned int hi = libm_next() >> 5, lo = libm_next() >> 6;
+    return (hi * 67108864.0 + lo) / 9007199254740992.0;
+}
+
+static double libm_signed(double magnitude) {
+    return (libm_next() & 0x80000000u) ? -magnitude : magnitude;
+}
+
+static void libm_make_input(int fn, int k, double* x, double* y) {
+    double u = libm_uniform();
+    *y = 0.0;
+    switch (fn) {
+        case 0: case 1: case 2:  // trig: near k*pi/2, huge, moderate, tiny
+            switch (k & 3) {
+                case 0: *x = (double)(libm_next() % 1000000) * 1.5707963267948966 + libm_signed(u * 1e-9); break;
+                case 1: *x = libm_signed(ldexp(1.0 + u, 20 + (int)(libm_next() % 1000))); break;
+                case 2: *x = libm_signed(u * 100.0); break;
+                default: *x = libm_signed(ldexp(1.0 + u, -(int)(libm_next() % 1000) - 17)); break;
+            }
+            break;
+        case 3:  // exp: near overflow, near underflow, around 0, moderate
+            switch (k & 3) {
+                case 0: *x = 709.0 + u * 0.78; break;
+                case 1: *x = -708.0 - u * 37.0; break;
+                case 2: *x = libm_signed(u * 1e-6); break;
+                default: *x = libm_signed(u * 50.0); break;
+            }
+            break;
+        case 4:  // log: near 1, subnormal, huge, moderate
+            switch (k & 3) {
+                case 0: *x = 1.0 + libm_signed(u * 1e-8); break;
+                case 1: *x = ldexp(1.0 + u, -1060); break;
+                case 2: *x = ldexp(1.0 + u, 900 + (int)(libm_next() % 120)); break;
+                default: *x = u * 1000.0 + 1e-3; break;
+            }
+            break;
+        case 5:  // pow: base near 1 with large exponent, moderate base and exponent
+            if (k & 1) {
+                *x = 1.0 + libm_signed(u * 1e-6);
+                *y = libm_signed(libm_uniform() * 1e6);
+            } else {
+                *x = u * 100.0;
+                *y = libm_signed(libm_uniform() * 50.0);
+            }
+            break;
+        case 6:  // atan2: all quadrants, extreme ratios
+            *x = libm_signed(ldexp(1.0 + u, (int)(libm_next() % 200) - 100));
+            *y = libm_signed(ldexp(1.0 + libm_uniform(), (int)(libm_next() % 200) - 100));
+            break;
+        default:  // cbrt: full exponent range
+            *x = libm_signed(ldexp(1.0 + u, (int)(libm_next() % 2000) - 1000));
+            break;
+    }
+}
+
+// inputs: 2 * count doubles (x, y per entry); results: count doubles. Returns the FNV-1a
+// hash of the result bits (little-endian bytes of each double).
+EMSCRIPTEN_KEEPALIVE
+unsigned int libm_table_test(double* inputs, double* results, int count) {
+    libm_seed = 0x1234567u;
+    unsigned int hash = 2166136261u;
+    for (int i = 0; i < count; i++) {
+        int fn = i % LIBM_FN_COUNT;
+        double x, y, r;
+        libm_make_input(fn, i / LIBM_FN_COUNT, &x, &y);
+        switch (fn) {
+            case 0: r = sin(x); break;
+            case 1: r = cos(x); break;
+            case 2: r = tan(x); break;
+            case 3: r = exp(x); break;
+            case 4: r = log(x); break;
+            case 5: r = pow(x, y); break;
+            case 6: r = atan2(y, x); break;
+            default: r = cbrt(x); break;
+        }
+        if (inputs) { inputs[2 * i] = x; inputs[2 * i + 1] = y; }
+        if (results) results[i] = r;
+
+        union { double d; uint64_t u; } bits = { r };
+        for (int b = 0; b < 64; b += 8) {
+            hash ^= (unsigned int)((bits.u >> b) & 0xFF);
+            hash *= 16777619u;
+        }
+    }
+    return hash;
+}
+
 // Fixed integer operation optimization pattern test
 EMSCRIPTEN_KEEPALIVE
 long integer_optimization_test(int iterations) {
@@ -259,195 +365,316 @@ double cache_behavior_test(int size_kb, int access_pattern) {
     return (double)sum;
 }
 
-// 分支预测器表大小检测 (BTB - Branch Target Buffer)
-EMSCRIPTEN_KEEPALIVE
-double btb_size_detection(int max_branches) {
-    volatile long correct_predictions = 0;
-    int likely_btb_size = 512;  // 默认值
-
-    // 测试不同数量的分支目标
-    for (int num_branches = 64; num_branches <= max_branches; num_branches *= 2) {
-        // 创建分支目标数组
-        volatile long* branch_targets = malloc(sizeof(long) * num_branches);
-        if (!branch_targets) continue;
-
-        // 初始化分支目标
-        for (int i = 0; i < num_branches; i++) {
-            branch_targets[i] = (i * 123456789L) % 1000000L;
-        }
+// Indirect call engine
+// call_indirect through generated targets (distinct code addresses) following a
+// precomputed target sequence of chosen cardinality and period; timed in-kernel.
+#define INDIRECT_MAX_POINTS 24
 
-        volatile long sum = 0;
-        int iterations = 10000;
+static volatile int indirect_sink = 0;
 
-        // 测试循环分支模式
-        for (int iter = 0; iter < iterations; iter++) {
-            for (int i = 0; i < num_branches; i++) {
-                // 间接跳转模式，测试BTB
-                int target_index = (i * 7) % num_branches;
-                sum += branch_targets[target_index];
-
-                // 条件分支，产生可预测模式
-                if (sum % 3 == 0) {
-                    sum += i;
-                } else if (sum % 3 == 1) {
-                    sum -= i;
-                } else {
-                    sum *= 2;
-                }
-            }
+// ns per indirect call. The sequence of `period` entries cycles through `targets`
+// distinct targets (each used once per `targets` entries, shuffled order), or is
+// fully random over them when period > targets.
+EMSCRIPTEN_KEEPALIVE
+double indirect_call_test(int targets, int period, int calls) {
+    if (targets < 1) targets = 1;
+    if (targets > indirect_target_count) targets = indirect_target_count;
+    if (period < targets) period = targets;
+    if (calls < period) calls = period;
+
+    indirect_target_fn* seq = malloc(sizeof(indirect_target_fn) * period);
+    int* perm = malloc(sizeof(int) * targets);
+    if (!seq || !perm) {
+        if (seq) free(seq);
+        if (perm) free(perm);
+        return -1.0;
+    }
+
+    unsigned int seed = 86420u + (unsigned int)targets * 31u + (unsigned int)period;
+    for (int i = 0; i < targets; i++) perm[i] = i;
+    for (int i = targets - 1; i > 0; i--) {
+        seed = seed * 1664525 + 1013904223;
+        int j = (int)((seed >> 8) % (unsigned int)(i + 1));
+        int tmp = perm[i]; perm[i] = perm[j]; perm[j] = tmp;
+    }
+    for (int i = 0; i < period; i++) {
+        int target;
+        if (period == targets) {
+            target = perm[i];
+        } else {
+            seed = seed * 1664525 + 1013904223;
+            target = (int)((seed >> 8) % (unsigned int)targets);
         }
+        seq[i] = indirect_targets[target];
+    }
+    free(perm);
 
-        // 使用执行时间代理（结果值）估算预测准确性
-        double prediction_score = (double)sum / (iterations * num_branches);
+    int reps = calls / period;
+    int acc = 1;
+    for (int i = 0; i < period; i++) acc = seq[i](acc);  // warm: train predictor, fault in code
 
-        // 当分支目标数量超过BTB容量时，性能应该下降
-        if (num_branches == 64) {
-            correct_predictions = (long)prediction_score;
-        } else if (prediction_score < correct_predictions * 0.8) {
-            // 性能下降20%时，认为超出BTB容量
-            likely_btb_size = num_branches / 2;
-            break;
+    double best_ns = -1.0;
+    for (int pass = 0; pass < 3; pass++) {
+        double start = probe_timer_start();
+        for (int r = 0; r < reps; r++) {
+            for (int i = 0; i < period; i++) acc = seq[i](acc);
         }
-
-        free((void*)branch_targets);
+        double ns = probe_timer_elapsed_ms(start) * 1e6 / ((double)reps * period);
+        if (best_ns < 0 || ns < best_ns) best_ns = ns;
     }
 
-    return (double)likely_btb_size;
+    indirect_sink = acc;
+    free(seq);
+    return best_ns;
 }
 
-// 分支历史表深度检测
+// Indirect predictor profile
+// out layout (doubles):
+//   [0] single-target ns/call   [1] random-target ns/call   [2] indirect mispredict penalty (ns)
+//   [3] target capacity: most targets cycled in a fixed order that are still predicted
+//   [4] history reach: longest random sequence over 16 targets still predicted
+//   [5] N, then N pairs (targets, ns) for cyclic sequences
+//   then M, then M pairs (period, ns) for 16-target random sequences
+// out must hold at least 8 + 6 * INDIRECT_MAX_POINTS doubles. Returns the capacity.
 EMSCRIPTEN_KEEPALIVE
-double branch_history_depth_test(int max_pattern_length) {
-    double best_prediction_score = 0;
-    int optimal_pattern_length = 4;  // 默认值
-
-    // 测试不同长度的分支历史模式
-    for (int pattern_len = 2; pattern_len <= max_pattern_length; pattern_len++) {
-        volatile long sum = 0;
-        int iterations = 10000;
-        int pattern_mask = (1 << pattern_len) - 1;
-
-        for (int iter = 0; iter < iterations; iter++) {
-            // 创建重复的分支模式
-            int pattern = iter & pattern_mask;
-
-            for (int i = 0; i < pattern_len * 100; i++) {
-                int branch_decision = (i & pattern_mask) == pattern;
-
-                if (branch_decision) {
-                    sum += i * 3;
-                } else {
-                    sum -= i;
-                }
-
-                // 额外的嵌套分支测试历史深度
-                if ((sum % (1 << pattern_len)) == 0) {
-                    if (branch_decision) {
-                        sum += pattern_len;
-                    } else {
-                        sum -= pattern_len;
-                    }
-                }
-            }
-        }
-
-        double prediction_score = (double)abs((int)sum) / (iterations * pattern_len * 100);
+double indirect_predictor_profile(double* out, int max_targets, int calls) {
+    if (max_targets > indirect_target_count) max_targets = indirect_target_count;
+    if (max_targets < 2) max_targets = 2;
+    if (calls < 10000) calls = 10000;
+
+    double mono_ns = indirect_call_test(1, 1, calls);
+    double random_ns = indirect_call_test(max_targets, 1 << 16, calls);
+    double penalty = (random_ns - mono_ns) / (1.0 - 1.0 / max_targets);
+    // Predicted while fewer than ~10% of calls miss
+    double threshold = mono_ns + (penalty > 0 ? penalty * 0.10 : 0.5);
+
+    int counts[INDIRECT_MAX_POINTS];
+    double count_ns[INDIRECT_MAX_POINTS];
+    int n = 0, capacity = 1;
+    for (int t = 2; t <= max_targets && n < INDIRECT_MAX_POINTS; t *= 2) {
+        counts[n] = t;
+        count_ns[n] = indirect_call_test(t, t, calls);
+        if (count_ns[n] <= threshold && capacity == t / 2) capacity = t;
+        n++;
+    }
 
-        // 寻找最佳预测模式长度
-        if (prediction_score > best_prediction_score) {
-            best_prediction_score = prediction_score;
-            optimal_pattern_length = pattern_len;
-        }
+    int periods[INDIRECT_MAX_POINTS];
+    double period_ns[INDIRECT_MAX_POINTS];
+    int m = 0, history = 16;
+    int hist_targets = max_targets < 16 ? max_targets : 16;
+    for (int period = 32; period <= 65536 && m < INDIRECT_MAX_POINTS; period *= 2) {
+        periods[m] = period;
+        period_ns[m] = indirect_call_test(hist_targets, period, calls);
+        if (period_ns[m] <= threshold && history == period / 2) history = period;
+        m++;
     }
 
-    return (double)optimal_pattern_length;
+    if (out) {
+        out[0] = mono_ns;
+        out[1] = random_ns;
+        out[2] = penalty;
+        out[3] = capacity;
+        out[4] = history;
+        int k = 5;
+        out[k++] = n;
+        for (int i = 0; i < n; i++) { out[k++] = counts[i]; out[k++] = count_ns[i]; }
+        out[k++] = m;
+        for (int i = 0; i < m; i++) { out[k++] = periods[i]; out[k++] = period_ns[i]; }
+    }
+    return (double)capacity;
 }
 
-// 测试函数定义
-static long test_func1(long x) { return x * 2; }
-static long test_func2(long x) { return x + 1; }
-static long test_func3(long x) { return x / 2; }
-static long test_func4(long x) { return x - 1; }
-
-// 间接分支预测器测试
+// 分支预测器表大小检测 (BTB - Branch Target Buffer)
+// Indirect target capacity: most distinct targets one call_indirect site still predicts
 EMSCRIPTEN_KEEPALIVE
-double indirect_branch_predictor_test(int num_targets) {
-    // 创建函数指针表模拟间接跳转
-    typedef long (*func_ptr)(long);
+double btb_size_detection(int max_branches) {
+    double out[8 + 6 * INDIRECT_MAX_POINTS];
+    if (indirect_predictor_profile(out, max_branches, 200000) < 0) return -1.0;
+    return out[3];
+}
 
-    func_ptr functions[] = {
-        test_func1,
-        test_func2,
-        test_func3,
-        test_func4
-    };
+// Timed branch engine
+// Conditional branches are driven from a precomputed pattern array, so the predictor
+// sees exactly the period and randomness we choose; time per branch is measured in-kernel.
+#define BRANCH_PATTERN_PERIODIC 0  // random bits of length `period`, repeated
+#define BRANCH_PATTERN_LOOP     1  // period-1 taken then one not-taken (loop exit)
+#define BRANCH_MAX_POINTS 24
+
+// Empty asm in one arm keeps the branch from being if-converted into a select
+#define BRANCH_BARRIER() __asm__ volatile("")
+
+static volatile long branch_sink = 0;
+
+static void branch_fill_pattern(unsigned char* pattern, int length, int period, int entropy_pct,
+                                int kind, unsigned int seed) {
+    if (period < 1) period = 1;
+    unsigned int base_seed = seed;
+    for (int i = 0; i < length; i++) {
+        int pos = i % period;
+        unsigned char bit;
+        if (kind == BRANCH_PATTERN_LOOP) {
+            bit = (pos != period - 1);
+        } else {
+            // Same pseudo-random bit for the same position in every period
+            unsigned int h = (base_seed + (unsigned int)pos) * 2654435761u;
+            bit = (h >> 16) & 1;
+        }
+        // Entropy: replace a fraction of positions with fresh random bits
+        seed = seed * 1664525 + 1013904223;
+        if ((int)((seed >> 8) % 100) < entropy_pct) {
+            seed = seed * 1664525 + 1013904223;
+            bit = (seed >> 16) & 1;
+        }
+        pattern[i] = bit;
+    }
+}
 
-    volatile long sum = 0;
-    int iterations = 50000;
-    unsigned int seed = 12345;
+// ns per conditional branch over `branches` executions of the pattern
+static double branch_run_ns(const unsigned char* pattern, int length, int branches) {
+    int reps = branches / length;
+    if (reps < 1) reps = 1;
+    long acc = 0;
 
-    for (int iter = 0; iter < iterations; iter++) {
-        // 生成间接跳转模式
-        for (int i = 0; i < num_targets; i++) {
-            seed = seed * 1664525 + 1013904223;
-            int func_index = seed % 4;
+    // Warm pass lets the predictor train on the pattern
+    for (int i = 0; i < length; i++) {
+        if (pattern[i]) { acc += i; BRANCH_BARRIER(); } else { acc ^= i; }
+    }
 
-            // 间接函数调用
-            long result = functions[func_index](iter + i);
-            sum += result;
+    // Best of three passes rejects interrupts and frequency hiccups
+    double best_ns = -1.0;
+    for (int pass = 0; pass < 3; pass++) {
+        double start = probe_timer_start();
+        for (int r = 0; r < reps; r++) {
+            for (int i = 0; i < length; i++) {
+                if (pattern[i]) { acc += i; BRANCH_BARRIER(); } else { acc ^= i; }
+            }
         }
+        double ns = probe_timer_elapsed_ms(start) * 1e6 / ((double)reps * length);
+        if (best_ns < 0 || ns < best_ns) best_ns = ns;
     }
 
-    return (double)sum / (iterations * num_targets);
+    branch_sink = acc;
+    return best_ns;
 }
 
-// 循环分支预测器测试
+// Time one pattern configuration; returns ns per branch
 EMSCRIPTEN_KEEPALIVE
-double loop_branch_predictor_test(int max_loop_depth) {
-    volatile long sum = 0;
-    double best_loop_depth = 0;
-
-    // 测试不同嵌套深度的循环
-    for (int depth = 1; depth <= max_loop_depth; depth++) {
-        int iterations = 1000 / depth;  // 调整迭代次数
+double branch_pattern_test(int kind, int period, int entropy_pct, int branches) {
+    int length = period * 16;
+    if (length < 4096) length = 4096;
+    if (length > (1 << 17)) length = 1 << 17;
+    // Random content must not repeat within reach of the predictor's history or it gets learned
+    if (entropy_pct > 0) length = 1 << 20;
+    length -= length % period;
+    if (length < period) length = period;
+
+    unsigned char* pattern = malloc(length);
+    if (!pattern) return -1.0;
+    branch_fill_pattern(pattern, length, period, entropy_pct, kind, 97531u + (unsigned int)period);
+    double ns = branch_run_ns(pattern, length, branches);
+    free(pattern);
+    return ns;
+}
 
-        for (int iter = 0; iter < iterations; iter++) {
-            // 生成嵌套循环结构
-            volatile long temp_sum = 0;
-
-            for (int i1 = 0; i1 < 10; i1++) {
-                if (depth > 1) {
-                    for (int i2 = 0; i2 < 10; i2++) {
-                        if (depth > 2) {
-                            for (int i3 = 0; i3 < 10; i3++) {
-                                if (depth > 3) {
-                                    for (int i4 = 0; i4 < 10; i4++) {
-                                        temp_sum += i1 + i2 + i3 + i4;
-                                    }
-                                } else {
-                                    temp_sum += i1 + i2 + i3;
-                                }
-                            }
-                        } else {
-                            temp_sum += i1 + i2;
-                        }
-                    }
-                } else {
-                    temp_sum += i1;
-                }
-            }
+// Branch predictor profile from timing curves
+// out layout (doubles):
+//   [0] predictable ns/branch   [1] fully random ns/branch   [2] mispredict penalty (ns)
+//   [3] history depth: longest random period still predicted
+//   [4] loop predictor: longest loop trip count whose exit is predicted
+//   [5] N, then N pairs (period, ns) for periodic random patterns
+//   then M, then M pairs (entropy %, ns)
+//   then L, then L pairs (trip count, ns) for loop-exit patterns
+// out must hold at least 8 + 6 * BRANCH_MAX_POINTS doubles. Returns the penalty.
+EMSCRIPTEN_KEEPALIVE
+double branch_predictor_profile(double* out, int max_period, int branches) {
+    static const int entropies[] = {0, 5, 10, 20, 35, 50, 75, 100};
+    int num_entropies = sizeof(entropies) / sizeof(entropies[0]);
+    if (max_period < 4) max_period = 4;
+    if (branches < 10000) branches = 10000;
+
+    // Mispredict penalty: ns/branch is linear in the miss rate (entropy / 2 on a
+    // predictable all-taken stream); the least-squares slope is the penalty
+    double ent_ns[BRANCH_MAX_POINTS];
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (int e = 0; e < num_entropies; e++) {
+        ent_ns[e] = branch_pattern_test(BRANCH_PATTERN_LOOP, 1, entropies[e], branches);
+        double miss = entropies[e] / 200.0;
+        sx += miss; sy += ent_ns[e]; sxx += miss * miss; sxy += miss * ent_ns[e];
+    }
+    double denom = num_entropies * sxx - sx * sx;
+    double penalty = denom > 0 ? (num_entropies * sxy - sx * sy) / denom : 0.0;
+    double base_ns = ent_ns[0];
+    double random_ns = ent_ns[num_entropies - 1];
+
+    // Still "predicted" while the miss rate stays under ~10%
+    double threshold = base_ns + (penalty > 0 ? penalty * 0.10 : 0.5);
+
+    int periods[BRANCH_MAX_POINTS];
+    double period_ns[BRANCH_MAX_POINTS];
+    int n = 0, depth = 1;
+    for (int period = 2; period <= max_period && n < BRANCH_MAX_POINTS; period *= 2) {
+        periods[n] = period;
+        period_ns[n] = branch_pattern_test(BRANCH_PATTERN_PERIODIC, period, 0, branches);
+        if (period_ns[n] <= threshold && depth == period / 2) depth = period;
+        n++;
+    }
 
-            sum += temp_sum;
+    int trips[BRANCH_MAX_POINTS];
+    double trip_ns[BRANCH_MAX_POINTS];
+    int l = 0;
+    double loop_floor = -1.0;
+    for (int trip = 2; trip <= max_period && l < BRANCH_MAX_POINTS; trip *= 2) {
+        trips[l] = trip;
+        trip_ns[l] = branch_pattern_test(BRANCH_PATTERN_LOOP, trip, 0, branches);
+        if (loop_floor < 0 || trip_ns[l] < loop_floor) loop_floor = trip_ns[l];
+        l++;
+    }
+    // One exit per trip: predicted while the extra cost per loop stays under half a miss
+    int loop_depth = 1;
+    for (int i = 0; i < l; i++) {
+        double extra_per_exit = (trip_ns[i] - loop_floor) * trips[i];
+        if (penalty > 0 && extra_per_exit < penalty * 0.5 && loop_depth == trips[i] / 2) {
+            loop_depth = trips[i];
         }
+    }
 
-        // 使用执行结果估算最优循环深度
-        double current_score = (double)sum / iterations;
-        if (current_score > best_loop_depth) {
-            best_loop_depth = depth;
-        }
+    if (out) {
+        out[0] = base_ns;
+        out[1] = random_ns;
+        out[2] = penalty;
+        out[3] = depth;
+        out[4] = loop_depth;
+        int k = 5;
+        out[k++] = n;
+        for (int i = 0; i < n; i++) { out[k++] = periods[i]; out[k++] = period_ns[i]; }
+        out[k++] = num_entropies;
+        for (int i = 0; i < num_entropies; i++) { out[k++] = entropies[i]; out[k++] = ent_ns[i]; }
+        out[k++] = l;
+        for (int i = 0; i < l; i++) { out[k++] = trips[i]; out[k++] = trip_ns[i]; }
     }
+    return penalty;
+}
+
+// 分支历史表深度检测 - longest random branch period the predictor still learns (timed)
+EMSCRIPTEN_KEEPALIVE
+double branch_history_depth_test(int max_pattern_length) {
+    double out[8 + 6 * BRANCH_MAX_POINTS];
+    if (branch_predictor_profile(out, max_pattern_length, 200000) < 0) return -1.0;
+    return out[3];
+}
 
-    return best_loop_depth;
+// 间接分支预测器测试 - ns per call_indirect over num_targets targets in random order (timed)
+EMSCRIPTEN_KEEPALIVE
+double indirect_branch_predictor_test(int num_targets) {
+    return indirect_call_test(num_targets, 1 << 16, 200000);
+}
+
+// 循环分支预测器测试 - longest loop trip count whose exit branch is predicted (timed)
+EMSCRIPTEN_KEEPALIVE
+double loop_branch_predictor_test(int max_loop_depth) {
+    double out[8 + 6 * BRANCH_MAX_POINTS];
+    if (branch_predictor_profile(out, max_loop_depth, 200000) < 0) return -1.0;
+    return out[4];
 }
 
 // Return Address Stack (RAS) 深度测试
@@ -489,4 +716,49 @@ double return_stack_depth_test(int max_call_depth) {
     }
 
     return (double)optimal_depth;
-}
\ No newline at end of file
+}
+
+// CPU frequency estimate
+// A dependent chain of 32-bit adds retires one add per cycle on every mainstream core, so
+// adds per nanosecond is the effective clock in GHz. The empty asm pins the running value
+// to a register after every add, which stops the chain being folded into a multiply.
+#define FREQ_UNROLL 32
+#define FREQ_ADD() x += step; __asm__ volatile("" : "+r"(x));
+#define FREQ_ADD8() FREQ_ADD() FREQ_ADD() FREQ_ADD() FREQ_ADD() FREQ_ADD() FREQ_ADD() FREQ_ADD() FREQ_ADD()
+
+static volatile int freq_step = 3;
+static volatile int freq_sink = 0;
+
+// Effective GHz from `adds` dependent adds per pass; best of 5 passes after a warm-up
+EMSCRIPTEN_KEEPALIVE
+double cpu_frequency_estimate(int adds) {
+    int rounds = adds / FREQ_UNROLL;
+    if (rounds < 1000) rounds = 1000;
+    int step = freq_step;
+    int x = 0;
+
+    double best_ns = -1.0;
+    for (int pass = 0; pass < 6; pass++) {
+        double start = probe_timer_start();
+        for (int r = 0; r < rounds; r++) {
+            FREQ_ADD8() FREQ_ADD8() FREQ_ADD8() FREQ_ADD8()
+        }
+        double ns = probe_timer_elapsed_ms(start) * 1e6 / ((double)rounds * FREQ_UNROLL);
+        if (pass > 0 && ns > 0 && (best_ns < 0 || ns < best_ns)) best_ns = ns;
+    }
+
+    freq_sink = x;
+    return best_ns > 0 ? 1.0 / best_ns : -1.0;
+}
+
+// Reference kernel for drift normalization: fixed register-only work (no memory traffic,
+// so it leaves cache state alone), timed from JS between probes
+EMSCRIPTEN_KEEPALIVE
+int reference_kernel(int rounds) {
+    int step = freq_step;
+    int x = 0;
+    for (int r = 0; r < rounds; r++) {
+        FREQ_ADD8() FREQ_ADD8() FREQ_ADD8() FREQ_ADD8()
+    }
+    return x;
+}
@@ -0,0 +1,13 @@
+#ifndef FOOTPRINT_BLOCKS_H
+#define FOOTPRINT_BLOCKS_H
+
+// ~4KB code blocks generated by tools/gen_kernels.py (build/gen/footprint-blocks.c)
+typedef unsigned int (*footprint_block_fn)(unsigned int, unsigned int);
+
+extern const footprint_block_fn footprint_straight[];
+extern const footprint_block_fn footprint_branchy[];
+extern const int footprint_straight_count;
+extern const int footprint_branchy_count;
+extern const int footprint_block_bytes;  // estimated wasm bytes per block
+
+#endif
@@ -0,0 +1,152 @@
+// Code footprint probe (built separately as build/footprint-probe.wasm)
+// The generated blocks are megabytes of code, so they live in their own module that
+// measureCodeFootprint fetches on demand instead of in the main module every page loads.
+// Standalone module: its only import is env.probe_now_ms (see probe-clock.c), see
+// Makefile target footprint-probe.
+#include "probe-platform.h"
+#include "probe-clock.h"
+#include "footprint-blocks.h"
+
+// Code footprint engine
+// Cycles through the first `blocks` generated ~4KB functions so the executed code
+// footprint grows while the work per block stays fixed; cost per KB of code rises as the
+// footprint spills out of the uop cache, L1i and L2. Footprints are in wasm bytes - the
+// JIT's machine code for a block is of similar size but varies per engine.
+#define FOOTPRINT_STRAIGHT 0
+#define FOOTPRINT_BRANCHY  1
+#define FOOTPRINT_MAX_POINTS 24
+#define FOOTPRINT_MAX_KNEES 3
+// Warm-up: whole passes over the blocks until pass time settles (the last
+// FOOTPRINT_WARM_WINDOW passes within 10% and none faster than the pass before by >5%)
+#define FOOTPRINT_WARM_WINDOW 3
+#define FOOTPRINT_WARM_MIN_PASSES 8
+#define FOOTPRINT_WARM_MAX_PASSES 512
+#define FOOTPRINT_WARM_MAX_MS 100.0
+
+static volatile unsigned int footprint_sink = 0;
+static volatile unsigned int footprint_mode = 0x2D4B6A35u;
+
+// Call every block until pass time settles. V8 has no OSR for wasm and tiers each block
+// up only after many calls, so one call per block would leave large footprints (few calls
+// per block in the timed passes) in baseline code and small ones optimized.
+static unsigned int footprint_warm(const footprint_block_fn* table, int blocks, unsigned int x, unsigned int mode) {
+    double times[FOOTPRINT_WARM_WINDOW + 1];
+    int settled = 0;
+    double warm_start = probe_now_ms();
+    for (int pass = 0; pass < FOOTPRINT_WARM_MAX_PASSES && !settled; pass++) {
+        double start = probe_now_ms();
+        for (int i = 0; i < blocks; i++) x = table[i](x, mode);
+        double now = probe_now_ms();
+        for (int k = 0; k < FOOTPRINT_WARM_WINDOW; k++) times[k] = times[k + 1];
+        times[FOOTPRINT_WARM_WINDOW] = now - start;
+        if (now - warm_start > FOOTPRINT_WARM_MAX_MS) break;
+        if (pass + 1 < FOOTPRINT_WARM_MIN_PASSES) continue;
+        double lo = times[1], hi = times[1];
+        settled = 1;
+        for (int k = 1; k <= FOOTPRINT_WARM_WINDOW; k++) {
+            if (times[k] < lo) lo = times[k];
+            if (times[k] > hi) hi = times[k];
+            if (times[k] < times[k - 1] * 0.95) settled = 0;
+        }
+        if (hi > lo * 1.1) settled = 0;
+    }
+    return x;
+}
+
+// ns per KB of code executed, cycling through `blocks` blocks of `family`
+EMSCRIPTEN_KEEPALIVE
+double code_footprint_test(int family, int blocks, int block_calls) {
+    const footprint_block_fn* table = family == FOOTPRINT_BRANCHY ? footprint_branchy : footprint_straight;
+    int count = family == FOOTPRINT_BRANCHY ? footprint_branchy_count : footprint_straight_count;
+    if (count < 1) return -1.0;
+    if (blocks < 1) blocks = 1;
+    if (blocks > count) blocks = count;
+    if (block_calls < blocks) block_calls = blocks;
+
+    int reps = block_calls / blocks;
+    unsigned int mode = footprint_mode;
+    unsigned int x = mode;
+    x = footprint_warm(table, blocks, x, mode);  // JIT tier-up, fault in code
+
+    double best_ns = -1.0;
+    for (int pass = 0; pass < 3; pass++) {
+        double start = probe_timer_start();
+        for (int r = 0; r < reps; r++) {
+            for (int i = 0; i < blocks; i++) x = table[i](x, mode);
+        }
+        double ns = probe_timer_elapsed_ms(start) * 1e6 / ((double)reps * blocks);
+        if (best_ns < 0 || ns < best_ns) best_ns = ns;
+    }
+
+    footprint_sink = x;
+    return best_ns * 1024.0 / footprint_block_bytes;
+}
+
+// Footprints (KB) after which cost per KB steps up by >20% and stays up; returns knee count
+static int footprint_knees(const double* kb, const double* ns, int n, double* knees) {
+    int found = 0;
+    if (n < 2) return 0;
+    double level = ns[0];
+    for (int i = 1; i < n && found < FOOTPRINT_MAX_KNEES; i++) {
+        int persists = i + 1 >= n || ns[i + 1] > level * 1.2;
+        if (ns[i] > level * 1.2 && persists) {
+            knees[found++] = kb[i - 1];
+            // A transition often spans two points; settle on the higher one
+            level = (i + 1 < n && ns[i + 1] > ns[i]) ? ns[++i] : ns[i];
+        } else if (ns[i] < level) {
+            level = ns[i];
+        }
+    }
+    return found;
+}
+
+// Code footprint profile
+// out layout (doubles):
+//   [0] straight-line ns/KB at the smallest footprint   [1..3] straight-line knees (KB, 0 = none)
+//   [4] branchy ns/KB at the smallest footprint         [5] first branchy knee (KB, 0 = none)
+//   [6] wasm bytes per block
+//   [7] N, then N pairs (KB, ns/KB) for straight-line blocks
+//   then M, then M pairs (KB, ns/KB) for branchy blocks
+// out must hold at least 8 + 4 * FOOTPRINT_MAX_POINTS doubles. Returns the first straight-line knee.
+EMSCRIPTEN_KEEPALIVE
+double code_footprint_profile(double* out, int max_kb, int block_calls) {
+    if (footprint_block_bytes <= 0) return -1.0;
+    int max_blocks = (int)((double)max_kb * 1024.0 / footprint_block_bytes + 0.5);
+    if (max_blocks < 1) max_blocks = 1;
+    if (block_calls < 1000) block_calls = 1000;
+    double block_kb = footprint_block_bytes / 1024.0;
+
+    double s_kb[FOOTPRINT_MAX_POINTS], s_ns[FOOTPRINT_MAX_POINTS];
+    double b_kb[FOOTPRINT_MAX_POINTS], b_ns[FOOTPRINT_MAX_POINTS];
+    int n = 0, m = 0;
+    for (int blocks = 1; blocks <= max_blocks && blocks <= footprint_straight_count && n < FOOTPRINT_MAX_POINTS; blocks *= 2) {
+        s_kb[n] = blocks * block_kb;
+        s_ns[n] = code_footprint_test(FOOTPRINT_STRAIGHT, blocks, block_calls);
+        n++;
+    }
+    for (int blocks = 1; blocks <= max_blocks && blocks <= footprint_branchy_count && m < FOOTPRINT_MAX_POINTS; blocks *= 2) {
+        b_kb[m] = blocks * block_kb;
+        b_ns[m] = code_footprint_test(FOOTPRINT_BRANCHY, blocks, block_calls);
+        m++;
+    }
+    if (n == 0) return -1.0;
+
+    double s_knees[FOOTPRINT_MAX_KNEES] = {0};
+    double b_knees[FOOTPRINT_MAX_KNEES] = {0};
+    footprint_knees(s_kb, s_ns, n, s_knees);
+    footprint_knees(b_kb, b_ns, m, b_knees);
+
+    if (out) {
+        out[0] = s_ns[0];
+        for (int i = 0; i < FOOTPRINT_MAX_KNEES; i++) out[1 + i] = s_knees[i];
+        out[4] = m > 0 ? b_ns[0] : -1.0;
+        out[5] = b_knees[0];
+        out[6] = footprint_block_bytes;
+        int k = 7;
+        out[k++] = n;
+        for (int i = 0; i < n; i++) { out[k++] = s_kb[i]; out[k++] = s_ns[i]; }
+        out[k++] = m;
+        for (int i = 0; i < m; i++) { out[k++] = b_kb[i]; out[k++] = b_ns[i]; }
+    }
+    return s_knees[0];
+}
@@ -0,0 +1,397 @@
+#include "probe-platform.h"
+#include <math.h>
+#include <stdint.h>
+#include "probe-clock.h"
+#ifdef __wasm_simd128__
+#include <wasm_simd128.h>
+#endif
+
+// FP pipeline kernels
+// Latency: one dependent chain of the op. Throughput: FP_THROUGHPUT_CHAINS independent
+// chains of the same op. latency / throughput ~= pipeline depth x number of ports.
+// WebAssembly has no scalar fused multiply-add, so FP_OP_MULADD is a dependent mul then
+// add (two roundings); sqrt is chained as sqrt(x) * a and fp_pipeline_profile removes the mul.
+// The scalar throughput chains must stay scalar: the default build has no vector type to
+// pack them into, and tools/build.py compiles this file with -fno-vectorize
+// -fno-slp-vectorize so the -msimd128 variant keeps them scalar too.
+#define FP_TYPE_F32   0
+#define FP_TYPE_F64   1
+#define FP_TYPE_F32X4 2
+#define FP_TYPE_F64X2 3
+#define FP_TYPE_COUNT 4
+
+#define FP_OP_ADD    0
+#define FP_OP_MUL    1
+#define FP_OP_MULADD 2
+#define FP_OP_DIV    3
+#define FP_OP_SQRT   4
+#define FP_OP_COUNT  5
+
+#define FP_LATENCY_UNROLL 8
+#define FP_THROUGHPUT_CHAINS 12
+
+static volatile unsigned char fp_sink[16];
+
+static void fp_consume(const void* value, int bytes) {
+    const unsigned char* p = (const unsigned char*)value;
+    for (int i = 0; i < bytes && i < 16; i++) fp_sink[i] ^= p[i];
+}
+
+// Operands per op, kept near 1 so chains neither overflow nor go subnormal
+static volatile double fp_operand_a[FP_OP_COUNT] = {1e-7, 1.0000001, 0.999999, 1.0000001, 1.5};
+static volatile double fp_operand_b[FP_OP_COUNT] = {0.0, 0.0, 1e-6, 0.0, 0.0};
+
+#define OP_ADD(x)    x = x + a;
+#define OP_MUL(x)    x = x * a;
+#define OP_MULADD(x) x = x * a + b;
+#define OP_DIV(x)    x = a / x;
+#define OP_SQRT(x)   x = sqrt(x) * a;
+#define OP_SQRTF(x)  x = sqrtf(x) * a;
+
+#ifdef __wasm_simd128__
+#define OP_F32X4_ADD(x)    x = wasm_f32x4_add(x, a);
+#define OP_F32X4_MUL(x)    x = wasm_f32x4_mul(x, a);
+#define OP_F32X4_MULADD(x) x = wasm_f32x4_add(wasm_f32x4_mul(x, a), b);
+#define OP_F32X4_DIV(x)    x = wasm_f32x4_div(a, x);
+#define OP_F32X4_SQRT(x)   x = wasm_f32x4_mul(wasm_f32x4_sqrt(x), a);
+#define OP_F64X2_ADD(x)    x = wasm_f64x2_add(x, a);
+#define OP_F64X2_MUL(x)    x = wasm_f64x2_mul(x, a);
+#define OP_F64X2_MULADD(x) x = wasm_f64x2_add(wasm_f64x2_mul(x, a), b);
+#define OP_F64X2_DIV(x)    x = wasm_f64x2_div(a, x);
+#define OP_F64X2_SQRT(x)   x = wasm_f64x2_mul(wasm_f64x2_sqrt(x), a);
+#endif
+
+#define SPLAT_F32(v) ((float)(v))
+#define SPLAT_F64(v) ((double)(v))
+#define SPLAT_F32X4(v) wasm_f32x4_splat((float)(v))
+#define SPLAT_F64X2(v) wasm_f64x2_splat(v)
+
+// Distinct starting values so the compiler cannot merge the chains
+#define FP_DECLARE_CHAINS(T, SPLAT) \
+    T x0 = SPLAT(x_in), x1 = SPLAT(x_in * 1.001), x2 = SPLAT(x_in * 1.002), \
+      x3 = SPLAT(x_in * 1.003), x4 = SPLAT(x_in * 1.004), x5 = SPLAT(x_in * 1.005), \
+      x6 = SPLAT(x_in * 1.006), x7 = SPLAT(x_in * 1.007), x8 = SPLAT(x_in * 1.008), \
+      x9 = SPLAT(x_in * 1.009), x10 = SPLAT(x_in * 1.010), x11 = SPLAT(x_in * 1.011);
+#define FP_STEP_CHAINS(OP) \
+    OP(x0) OP(x1) OP(x2) OP(x3) OP(x4) OP(x5) OP(x6) OP(x7) OP(x8) OP(x9) OP(x10) OP(x11)
+#define FP_CONSUME_CHAINS() \
+    fp_consume(&x0, sizeof(x0)); fp_consume(&x1, sizeof(x1)); fp_consume(&x2, sizeof(x2)); \
+    fp_consume(&x3, sizeof(x3)); fp_consume(&x4, sizeof(x4)); fp_consume(&x5, sizeof(x5)); \
+    fp_consume(&x6, sizeof(x6)); fp_consume(&x7, sizeof(x7)); fp_consume(&x8, sizeof(x8)); \
+    fp_consume(&x9, sizeof(x9)); fp_consume(&x10, sizeof(x10)); fp_consume(&x11, sizeof(x11));
+
+// name(throughput, a, b, x0, iterations) -> ns per op, best of 3 after a warm-up pass
+#define FP_KERNEL(name, T, SPLAT, OP) \
+static double name(int throughput, double a_in, double b_in, double x_in, int iterations) { \
+    T a = SPLAT(a_in), b = SPLAT(b_in); \
+    (void)b; \
+    double best_ns = -1.0; \
+    for (int pass = 0; pass < 4; pass++) { \
+        double start, ns; \
+        if (!throughput) { \
+            T x = SPLAT(x_in); \
+            start = probe_timer_start(); \
+            for (int i = 0; i < iterations; i++) { \
+                OP(x) OP(x) OP(x) OP(x) OP(x) OP(x) OP(x) OP(x) \
+            } \
+            ns = probe_timer_elapsed_ms(start) * 1e6 / ((double)iterations * FP_LATENCY_UNROLL); \
+            fp_consume(&x, sizeof(x)); \
+        } else { \
+            FP_DECLARE_CHAINS(T, SPLAT) \
+            start = probe_timer_start(); \
+            for (int i = 0; i < iterations; i++) { \
+                FP_STEP_CHAINS(OP) \
+            } \
+            ns = probe_timer_elapsed_ms(start) * 1e6 / ((double)iterations * FP_THROUGHPUT_CHAINS); \
+            FP_CONSUME_CHAINS() \
+        } \
+        if (pass > 0 && (best_ns < 0 || ns < best_ns)) best_ns = ns; \
+    } \
+    return best_ns; \
+}
+
+typedef double (*fp_kernel_fn)(int, double, double, double, int);
+
+FP_KERNEL(fp_f32_add, float, SPLAT_F32, OP_ADD)
+FP_KERNEL(fp_f32_mul, float, SPLAT_F32, OP_MUL)
+FP_KERNEL(fp_f32_muladd, float, SPLAT_F32, OP_MULADD)
+FP_KERNEL(fp_f32_div, float, SPLAT_F32, OP_DIV)
+FP_KERNEL(fp_f32_sqrt, float, SPLAT_F32, OP_SQRTF)
+FP_KERNEL(fp_f64_add, double, SPLAT_F64, OP_ADD)
+FP_KERNEL(fp_f64_mul, double, SPLAT_F64, OP_MUL)
+FP_KERNEL(fp_f64_muladd, double, SPLAT_F64, OP_MULADD)
+FP_KERNEL(fp_f64_div, double, SPLAT_F64, OP_DIV)
+FP_KERNEL(fp_f64_sqrt, double, SPLAT_F64, OP_SQRT)
+
+#ifdef __wasm_simd128__
+FP_KERNEL(fp_f32x4_add, v128_t, SPLAT_F32X4, OP_F32X4_ADD)
+FP_KERNEL(fp_f32x4_mul, v128_t, SPLAT_F32X4, OP_F32X4_MUL)
+FP_KERNEL(fp_f32x4_muladd, v128_t, SPLAT_F32X4, OP_F32X4_MULADD)
+FP_KERNEL(fp_f32x4_div, v128_t, SPLAT_F32X4, OP_F32X4_DIV)
+FP_KERNEL(fp_f32x4_sqrt, v128_t, SPLAT_F32X4, OP_F32X4_SQRT)
+FP_KERNEL(fp_f64x2_add, v128_t, SPLAT_F64X2, OP_F64X2_ADD)
+FP_KERNEL(fp_f64x2_mul, v128_t, SPLAT_F64X2, OP_F64X2_MUL)
+FP_KERNEL(fp_f64x2_muladd, v128_t, SPLAT_F64X2, OP_F64X2_MULADD)
+FP_KERNEL(fp_f64x2_div, v128_t, SPLAT_F64X2, OP_F64X2_DIV)
+FP_KERNEL(fp_f64x2_sqrt, v128_t, SPLAT_F64X2, OP_F64X2_SQRT)
+#endif
+
+static const fp_kernel_fn fp_kernels[FP_TYPE_COUNT][FP_OP_COUNT] = {
+    {fp_f32_add, fp_f32_mul, fp_f32_muladd, fp_f32_div, fp_f32_sqrt},
+    {fp_f64_add, fp_f64_mul, fp_f64_muladd, fp_f64_div, fp_f64_sqrt},
+#ifdef __wasm_simd128__
+    {fp_f32x4_add, fp_f32x4_mul, fp_f32x4_muladd, fp_f32x4_div, fp_f32x4_sqrt},
+    {fp_f64x2_add, fp_f64x2_mul, fp_f64x2_muladd, fp_f64x2_div, fp_f64x2_sqrt},
+#else
+    {0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0},
+#endif
+};
+
+// ns per op for one (type, op): latency when throughput == 0, else throughput.
+// Returns -1 for SIMD types when the module is built without -msimd128.
+EMSCRIPTEN_KEEPALIVE
+double fp_op_test(int type, int op, int throughput, int iterations) {
+    if (type < 0 || type >= FP_TYPE_COUNT || op < 0 || op >= FP_OP_COUNT) return -1.0;
+    fp_kernel_fn fn = fp_kernels[type][op];
+    if (!fn) return -1.0;
+    if (iterations < 1000) iterations = 1000;
+    return fn(throughput, fp_operand_a[op], fp_operand_b[op], 1.25, iterations);
+}
+
+// FP pipeline profile
+// out layout (doubles): for type t (f32, f64, f32x4, f64x2) and op o (add, mul, muladd,
+// div, sqrt): out[(t * 5 + o) * 2] = latency ns, out[(t * 5 + o) * 2 + 1] = throughput ns
+// per op; -1 when unsupported. out must hold FP_TYPE_COUNT * FP_OP_COUNT * 2 doubles.
+// Returns the number of types measured.
+EMSCRIPTEN_KEEPALIVE
+int fp_pipeline_profile(double* out, int iterations) {
+    int types = 0;
+    for (int t = 0; t < FP_TYPE_COUNT; t++) {
+        double* row = out + t * FP_OP_COUNT * 2;
+        if (!fp_kernels[t][0]) {
+            for (int i = 0; i < FP_OP_COUNT * 2; i++) row[i] = -1.0;
+            continue;
+        }
+        for (int o = 0; o < FP_OP_COUNT; o++) {
+            row[o * 2] = fp_op_test(t, o, 0, iterations);
+            row[o * 2 + 1] = fp_op_test(t, o, 1, iterations);
+        }
+        // sqrt chains carry a mul; the remainder is the sqrt itself
+        row[FP_OP_SQRT * 2] -= row[FP_OP_MUL * 2];
+        if (row[FP_OP_SQRT * 2] < 0) row[FP_OP_SQRT * 2] = 0;
+        types++;
+    }
+    return types;
+}
+
+// Denormal penalty
+// The same dependent chains run once on normal and once on subnormal values. WebAssembly
+// requires IEEE subnormals (no flush-to-zero), so cores that handle them with microcode
+// assists show large ratios here; others run both at full speed.
+//   add:    x = (x + a) - a       keeps x subnormal when x and a are
+//   mul:    x = (x * 2) * 0.5     exact round trip on subnormals
+//   muladd: x = x * 0.5 + b       converges to 2b (wasm has no scalar fma)
+#define DENORM_OP_ADD    0
+#define DENORM_OP_MUL    1
+#define DENORM_OP_MULADD 2
+#define DENORM_OP_COUNT  3
+
+#define DN_ADD(x)    x = x + a; x = x - a;
+#define DN_MUL(x)    x = x * a; x = x * b;
+#define DN_MULADD(x) x = x * a + b; x = x * a + b;
+
+#ifdef __wasm_simd128__
+#define DN_F32X4_ADD(x)    x = wasm_f32x4_sub(wasm_f32x4_add(x, a), a);
+#define DN_F32X4_MUL(x)    x = wasm_f32x4_mul(wasm_f32x4_mul(x, a), b);
+#define DN_F32X4_MULADD(x) x = wasm_f32x4_add(wasm_f32x4_mul(x, a), b); x = wasm_f32x4_add(wasm_f32x4_mul(x, a), b);
+#define DN_F64X2_ADD(x)    x = wasm_f64x2_sub(wasm_f64x2_add(x, a), a);
+#define DN_F64X2_MUL(x)    x = wasm_f64x2_mul(wasm_f64x2_mul(x, a), b);
+#define DN_F64X2_MULADD(x) x = wasm_f64x2_add(wasm_f64x2_mul(x, a), b); x = wasm_f64x2_add(wasm_f64x2_mul(x, a), b);
+#endif
+
+// name(x0, a, b, iterations) -> ns per op (two ops per DN_* step), best of 3 after a warm-up
+#define DENORM_KERNEL(name, T, SPLAT, OP) \
+static double name(double x_in, double a_in, double b_in, int iterations) { \
+    T a = SPLAT(a_in), b = SPLAT(b_in); \
+    (void)b; \
+    double best_ns = -1.0; \
+    for (int pass = 0; pass < 4; pass++) { \
+        T x = SPLAT(x_in); \
+        double start = probe_timer_start(); \
+        for (int i = 0; i < iterations; i++) { \
+            OP(x) OP(x) OP(x) OP(x) \
+        } \
+        double ns = probe_timer_elapsed_ms(start) * 1e6 / ((double)iterations * 8); \
+        fp_consume(&x, sizeof(x)); \
+        if (pass > 0 && (best_ns < 0 || ns < best_ns)) best_ns = ns; \
+    } \
+    return best_ns; \
+}
+
+typedef double (*denorm_kernel_fn)(double, double, double, int);
+
+DENORM_KERNEL(denorm_f32_add, float, SPLAT_F32, DN_ADD)
+DENORM_KERNEL(denorm_f32_mul, float, SPLAT_F32, DN_MUL)
+DENORM_KERNEL(denorm_f32_muladd, float, SPLAT_F32, DN_MULADD)
+DENORM_KERNEL(denorm_f64_add, double, SPLAT_F64, DN_ADD)
+DENORM_KERNEL(denorm_f64_mul, double, SPLAT_F64, DN_MUL)
+DENORM_KERNEL(denorm_f64_muladd, double, SPLAT_F64, DN_MULADD)
+
+#ifdef __wasm_simd128__
+DENORM_KERNEL(denorm_f32x4_add, v128_t, SPLAT_F32X4, DN_F32X4_ADD)
+DENORM_KERNEL(denorm_f32x4_mul, v128_t, SPLAT_F32X4, DN_F32X4_MUL)
+DENORM_KERNEL(denorm_f32x4_muladd, v128_t, SPLAT_F32X4, DN_F32X4_MULADD)
+DENORM_KERNEL(denorm_f64x2_add, v128_t, SPLAT_F64X2, DN_F64X2_ADD)
+DENORM_KERNEL(denorm_f64x2_mul, v128_t, SPLAT_F64X2, DN_F64X2_MUL)
+DENORM_KERNEL(denorm_f64x2_muladd, v128_t, SPLAT_F64X2, DN_F64X2_MULADD)
+#endif
+
+static const denorm_kernel_fn denorm_kernels[FP_TYPE_COUNT][DENORM_OP_COUNT] = {
+    {denorm_f32_add, denorm_f32_mul, denorm_f32_muladd},
+    {denorm_f64_add, denorm_f64_mul, denorm_f64_muladd},
+#ifdef __wasm_simd128__
+    {denorm_f32x4_add, denorm_f32x4_mul, denorm_f32x4_muladd},
+    {denorm_f64x2_add, denorm_f64x2_mul, denorm_f64x2_muladd},
+#else
+    {0, 0, 0},
+    {0, 0, 0},
+#endif
+};
+
+// A subnormal of each type's precision (f32 / f64 lanes)
+static volatile double denorm_tiny_f32 = 1e-39;
+static volatile double denorm_tiny_f64 = 1e-310;
+
+// ns per op on normal (subnormal == 0) or subnormal operands; -1 if unsupported
+EMSCRIPTEN_KEEPALIVE
+double denormal_op_test(int type, int op, int subnormal, int iterations) {
+    if (type < 0 || type >= FP_TYPE_COUNT || op < 0 || op >= DENORM_OP_COUNT) return -1.0;
+    denorm_kernel_fn fn = denorm_kernels[type][op];
+    if (!fn) return -1.0;
+    if (iterations < 1000) iterations = 1000;
+
+    int f32_lanes = type == FP_TYPE_F32 || type == FP_TYPE_F32X4;
+    double s = f32_lanes ? denorm_tiny_f32 : denorm_tiny_f64;
+    switch (op) {
+        case DENORM_OP_ADD:
+            return subnormal ? fn(3 * s, s, 0, iterations) : fn(1.0, 1e-3, 0, iterations);
+        case DENORM_OP_MUL:
+            return subnormal ? fn(3 * s, 2.0, 0.5, iterations) : fn(1.5, 2.0, 0.5, iterations);
+        default:
+            return subnormal ? fn(s, 0.5, s, iterations) : fn(1.0, 0.5, 1.0, iterations);
+    }
+}
+
+// Denormal penalty profile
+// out layout (doubles): for type t (f32, f64, f32x4, f64x2) and op o (add, mul, muladd):
+// out[(t * 3 + o) * 2] = normal ns/op, out[(t * 3 + o) * 2 + 1] = subnormal ns/op; -1 when
+// unsupported. out must hold FP_TYPE_COUNT * DENORM_OP_COUNT * 2 doubles.
+// Returns the largest subnormal/normal ratio.
+EMSCRIPTEN_KEEPALIVE
+double denormal_penalty_profile(double* out, int iterations) {
+    double worst = -1.0;
+    for (int t = 0; t < FP_TYPE_COUNT; t++) {
+        for (int o = 0; o < DENORM_OP_COUNT; o++) {
+            double normal = denormal_op_test(t, o, 0, iterations);
+            double sub = normal > 0 ? denormal_op_test(t, o, 1, iterations) : -1.0;
+            out[(t * DENORM_OP_COUNT + o) * 2] = normal;
+            out[(t * DENORM_OP_COUNT + o) * 2 + 1] = sub;
+            if (normal > 0 && sub > 0 && sub / normal > worst) worst = sub / normal;
+        }
+    }
+    return worst;
+}
+
+// NaN propagation probe
+// Which NaN comes out of an operation (payload, sign, quiet bit) is left open by the wasm
+// spec and engines pass the hardware result through: x86 generates the default NaN with
+// the sign bit set (0xFFC00000) and returns the first source's payload, ARM generates a
+// positive default NaN and orders operands differently; wasm min/max lowerings also differ.
+// Inputs are volatile so nothing is folded at compile time.
+#define NAN_PROBE_WORDS 28
+
+#ifdef __wasm__
+#define NAN_MIN_F32(a, b) __builtin_wasm_min_f32(a, b)
+#define NAN_MAX_F32(a, b) __builtin_wasm_max_f32(a, b)
+#define NAN_MIN_F64(a, b) __builtin_wasm_min_f64(a, b)
+#else
+#define NAN_MIN_F32(a, b) ((a) < (b) ? (a) : (b))
+#define NAN_MAX_F32(a, b) ((a) > (b) ? (a) : (b))
+#define NAN_MIN_F64(a, b) ((a) < (b) ? (a) : (b))
+#endif
+
+static volatile uint32_t nan_f32_bits[4] = {
+    0x7FC12345u,  // quiet NaN, payload A
+    0x7FD0BEEFu,  // quiet NaN, payload B
+    0x7F812345u,  // signalling NaN
+    0xFFC12345u   // negative quiet NaN, payload A
+};
+static volatile uint64_t nan_f64_bits[2] = {
+    0x7FF8123456789ABCull,  // quiet NaN, payload A
+    0x7FFC0FEDCBA98765ull   // quiet NaN, payload B
+};
+static volatile float nan_f32_one = 1.0f, nan_f32_zero = 0.0f, nan_f32_inf = INFINITY;
+static volatile double nan_f64_one = 1.0, nan_f64_zero = 0.0, nan_f64_inf = INFINITY;
+
+static float nan_f32(int i) { union { uint32_t u; float f; } v = { nan_f32_bits[i] }; return v.f; }
+static double nan_f64(int i) { union { uint64_t u; double f; } v = { nan_f64_bits[i] }; return v.f; }
+static uint32_t nan_bits32(float f) { union { float f; uint32_t u; } v = { f }; return v.u; }
+static uint64_t nan_bits64(double f) { union { double f; uint64_t u; } v = { f }; return v.u; }
+
+// Writes NAN_PROBE_WORDS result words to out (f64 results take two words, high then low;
+// SIMD slots are 0 when built without -msimd128). Returns an FNV-1a hash of the words.
+EMSCRIPTEN_KEEPALIVE
+uint32_t nan_propagation_probe(uint32_t* out) {
+    float qa = nan_f32(0), qb = nan_f32(1), sa = nan_f32(2), nqa = nan_f32(3);
+    float one = nan_f32_one, zero = nan_f32_zero, inf = nan_f32_inf;
+    double dqa = nan_f64(0), dqb = nan_f64(1);
+    double done = nan_f64_one, dzero = nan_f64_zero, dinf = nan_f64_inf;
+    uint64_t w;
+
+    out[0] = nan_bits32(qa + one);
+    out[1] = nan_bits32(one + qa);
+    out[2] = nan_bits32(qa + qb);
+    out[3] = nan_bits32(qb + qa);
+    out[4] = nan_bits32(sa * one);          // signalling -> quiet
+    out[5] = nan_bits32(nqa * one);         // sign of the propagated NaN
+    out[6] = nan_bits32(zero * inf);        // default NaN: x86 0xFFC00000, ARM 0x7FC00000
+    out[7] = nan_bits32(inf - inf);
+    out[8] = nan_bits32(NAN_MIN_F32(qa, one));
+    out[9] = nan_bits32(NAN_MAX_F32(one, nqa));
+    out[10] = nan_bits32(sqrtf(-one));
+    w = nan_bits64((double)qa);             // promote keeps the payload in the top bits
+    out[11] = (uint32_t)(w >> 32); out[12] = (uint32_t)w;
+    w = nan_bits64(dqa + done);
+    out[13] = (uint32_t)(w >> 32); out[14] = (uint32_t)w;
+    w = nan_bits64(dqa + dqb);
+    out[15] = (uint32_t)(w >> 32); out[16] = (uint32_t)w;
+    w = nan_bits64(dzero * dinf);
+    out[17] = (uint32_t)(w >> 32); out[18] = (uint32_t)w;
+    w = nan_bits64(NAN_MIN_F64(dqa, done));
+    out[19] = (uint32_t)(w >> 32); out[20] = (uint32_t)w;
+    out[21] = nan_bits32((float)dqa);       // demote drops the low payload bits
+    w = nan_bits64(dzero / dzero);
+    out[22] = (uint32_t)(w >> 32); out[23] = (uint32_t)w;
+
+#ifdef __wasm_simd128__
+    v128_t vq = wasm_f32x4_make(qa, qb, sa, nqa);
+    v128_t vone = wasm_f32x4_splat(one);
+    out[24] = nan_bits32(wasm_f32x4_extract_lane(wasm_f32x4_add(vq, vone), 0));
+    out[25] = nan_bits32(wasm_f32x4_extract_lane(wasm_f32x4_mul(wasm_f32x4_splat(zero), wasm_f32x4_splat(inf)), 0));
+    out[26] = nan_bits32(wasm_f32x4_extract_lane(wasm_f32x4_min(vq, vone), 1));
+    out[27] = (uint32_t)(nan_bits64(wasm_f64x2_extract_lane(
+        wasm_f64x2_mul(wasm_f64x2_splat(dzero), wasm_f64x2_splat(dinf)), 0)) >> 32);
+#else
+    out[24] = out[25] = out[26] = out[27] = 0;
+#endif
+
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < NAN_PROBE_WORDS; i++) {
+        for (int b = 0; b < 32; b += 8) {
+            hash ^= (out[i] >> b) & 0xFF;
+            hash *= 16777619u;
+        }
+    }
+    return hash;
+}
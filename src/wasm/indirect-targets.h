@@ -0,0 +1,10 @@
+#ifndef INDIRECT_TARGETS_H
+#define INDIRECT_TARGETS_H
+
+// Distinct noinline call targets generated by tools/gen_kernels.py (build/gen/indirect-targets.c)
+typedef int (*indirect_target_fn)(int);
+
+extern const indirect_target_fn indirect_targets[];
+extern const int indirect_target_count;
+
+#endif
@@ -1,6 +1,8 @@
-#include <emscripten.h>
+#include "probe-platform.h"
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include "probe-clock.h"
 
 // High-intensity memory access test - sequential access
 EMSCRIPTEN_KEEPALIVE
@@ -88,6 +90,38 @@ double random_access_test(int size_kb, int iterations) {
     return (double)sum;
 }
 
+// Persistent eviction buffer for cache_flush (grown on demand, kept for the page lifetime)
+static char* eviction_buffer = NULL;
+static int eviction_buffer_size = 0;
+
+// Cache eviction - stream one read per cache line over a buffer larger than the LLC.
+// Replaces the old random_access_test(8192, 3) flush: no per-call malloc/memset and
+// the caller sizes it from the measured LLC so large caches are actually evicted.
+EMSCRIPTEN_KEEPALIVE
+double cache_flush(int bytes) {
+    if (bytes <= 0) return 0.0;
+
+    if (bytes > eviction_buffer_size) {
+        char* grown = realloc(eviction_buffer, bytes);
+        if (grown) {
+            // Touch new pages once so later flushes never pay first-touch faults
+            memset(grown + eviction_buffer_size, 1, bytes - eviction_buffer_size);
+            eviction_buffer = grown;
+            eviction_buffer_size = bytes;
+        } else if (!eviction_buffer) {
+            return -1.0;
+        } else {
+            bytes = eviction_buffer_size;  // Fall back to the largest buffer we have
+        }
+    }
+
+    long sum = 0;
+    for (int i = 0; i < bytes; i += 64) {
+        sum += eviction_buffer[i];
+    }
+    return (double)sum;
+}
+
 // Stride access test - fixed prefetcher detection logic
 EMSCRIPTEN_KEEPALIVE
 double stride_access_test(int size_kb, int stride, int iterations) {
@@ -154,6 +188,219 @@ double stride_access_test(int size_kb, int stride, int iterations) {
     return (double)access_count;
 }
 
+// Prefetcher characterization - every pattern is a dependent pointer chase over the same
+// lines, so only the visiting order differs from the randomized baseline and any speedup
+// comes from the hardware prefetcher rather than overlapping independent loads.
+#define PREFETCH_FORWARD    0  // unit stride (one cache line) forward
+#define PREFETCH_BACKWARD   1  // unit stride backward
+#define PREFETCH_STRIDE     2  // constant stride of param bytes (multiple of 64)
+#define PREFETCH_STREAMS    3  // param interleaved forward streams in separate regions
+#define PREFETCH_PAGE_LOCAL 4  // runs of param lines aligned to page starts, runs in random order
+#define PREFETCH_PAGE_CROSS 5  // same runs shifted by half a run so each straddles a page boundary
+#define PREFETCH_RANDOM     6  // randomized chase baseline
+
+static unsigned int prefetch_lcg(unsigned int* seed) {
+    *seed = *seed * 1664525 + 1013904223;
+    return *seed;
+}
+
+// Fill order[] with a permutation of line indices 0..count-1 for the given pattern
+static void prefetch_fill_order(int* order, int count, int pattern, int param) {
+    unsigned int seed = 24680;
+
+    switch (pattern) {
+    case PREFETCH_BACKWARD:
+        for (int i = 0; i < count; i++) order[i] = count - 1 - i;
+        break;
+
+    case PREFETCH_STRIDE: {
+        // Laps of the stride, each shifted by one line, so every line is visited once
+        int step = param / 64;
+        if (step < 1) step = 1;
+        int k = 0;
+        for (int lap = 0; lap < step; lap++) {
+            for (int line = lap; line < count; line += step) order[k++] = line;
+        }
+        break;
+    }
+
+    case PREFETCH_STREAMS: {
+        int streams = param < 1 ? 1 : param;
+        int per_stream = count / streams;
+        int k = 0;
+        for (int i = 0; i < per_stream; i++) {
+            for (int s = 0; s < streams; s++) order[k++] = s * per_stream + i;
+        }
+        for (int line = per_stream * streams; line < count; line++) order[k++] = line;
+        break;
+    }
+
+    case PREFETCH_PAGE_LOCAL:
+    case PREFETCH_PAGE_CROSS: {
+        int run = param < 2 ? 2 : param;
+        int runs = count / run;
+        int shift = (pattern == PREFETCH_PAGE_CROSS) ? run / 2 : 0;
+        int* run_order = malloc(sizeof(int) * runs);
+        if (!run_order) {
+            for (int i = 0; i < count; i++) order[i] = i;
+            break;
+        }
+        for (int r = 0; r < runs; r++) run_order[r] = r;
+        for (int r = runs - 1; r > 0; r--) {
+            int j = (int)(prefetch_lcg(&seed) % (unsigned int)(r + 1));
+            int tmp = run_order[r]; run_order[r] = run_order[j]; run_order[j] = tmp;
+        }
+        int k = 0;
+        for (int r = 0; r < runs; r++) {
+            for (int i = 0; i < run; i++) order[k++] = (run_order[r] * run + i + shift) % (runs * run);
+        }
+        for (int line = runs * run; line < count; line++) order[k++] = line;
+        free(run_order);
+        break;
+    }
+
+    case PREFETCH_RANDOM:
+        for (int i = 0; i < count; i++) order[i] = i;
+        for (int i = count - 1; i > 0; i--) {
+            int j = (int)(prefetch_lcg(&seed) % (unsigned int)(i + 1));
+            int tmp = order[i]; order[i] = order[j]; order[j] = tmp;
+        }
+        break;
+
+    case PREFETCH_FORWARD:
+    default:
+        for (int i = 0; i < count; i++) order[i] = i;
+        break;
+    }
+}
+
+// Time `steps` dependent loads following one prefetch pattern; returns ns per access
+EMSCRIPTEN_KEEPALIVE
+double prefetch_pattern_test(int pattern, int param, int size_kb, int steps) {
+    int size = size_kb * 1024;
+    int count = size / 64;
+    if (count < 2 || steps < 1) return -1.0;
+
+    // Round the base up to a page so page-local runs stay inside one page and every node
+    // occupies exactly one cache line
+    char* raw = malloc(size + 4096);
+    int* order = malloc(sizeof(int) * count);
+    if (!raw || !order) {
+        if (raw) free(raw);
+        if (order) free(order);
+        return -1.0;
+    }
+    char* buffer = (char*)(((uintptr_t)raw + 4095) & ~(uintptr_t)4095);
+
+    prefetch_fill_order(order, count, pattern, param);
+    for (int i = 0; i < count; i++) {
+        char* from = buffer + (long)order[i] * 64;
+        *(char**)from = buffer + (long)order[(i + 1) % count] * 64;
+    }
+    char* p = buffer + (long)order[0] * 64;
+    free(order);
+
+    double start = probe_timer_start();
+    for (int i = 0; i < steps; i++) p = *(char**)p;
+    double ns = probe_timer_elapsed_ms(start) * 1e6 / steps;
+
+    // Keep the chase live
+    if (p == NULL) ns += 1.0;
+    free(raw);
+    return ns;
+}
+
+// Memory-level parallelism - walk 1..32 independent pointer chains in lockstep over one
+// randomized cycle. Loads within a step are independent, so per-access latency falls
+// until the core runs out of line fill buffers / MSHRs.
+#define MLP_MAX_CHAINS 32
+
+static double mlp_chase_ns(char** starts, int chains, int accesses) {
+    char* p[MLP_MAX_CHAINS];
+    for (int c = 0; c < chains; c++) p[c] = starts[c];
+    int rounds = accesses / chains;
+    if (rounds < 1) rounds = 1;
+
+    double start = probe_timer_start();
+    for (int r = 0; r < rounds; r++) {
+        for (int c = 0; c < chains; c++) p[c] = *(char**)p[c];
+    }
+    double ns = probe_timer_elapsed_ms(start) * 1e6 / ((double)rounds * chains);
+
+    // Keep every chain live
+    for (int c = 0; c < chains; c++) if (p[c] == NULL) ns += 1.0;
+    return ns;
+}
+
+// out layout (doubles):
+//   [0] peak speedup over one chain (sustained outstanding misses)
+//   [1] chain count reaching 90% of the peak
+//   [2] N, then N pairs (chains, ns per access)
+// out must hold at least 3 + 2 * MLP_MAX_CHAINS doubles. Returns the peak speedup.
+EMSCRIPTEN_KEEPALIVE
+double mlp_profile(double* out, int size_kb, int steps) {
+    static const int sweep[] = {1, 2, 3, 4, 5, 6, 8, 10, 12, 14, 16, 20, 24, 28, 32};
+    int num_sweep = sizeof(sweep) / sizeof(sweep[0]);
+    int size = size_kb * 1024;
+    int count = size / 64;
+    if (count < MLP_MAX_CHAINS * 2 || steps < 1) return -1.0;
+
+    char* buffer = malloc(size);
+    int* order = malloc(sizeof(int) * count);
+    if (!buffer || !order) {
+        if (buffer) free(buffer);
+        if (order) free(order);
+        return -1.0;
+    }
+
+    // One random cycle over every line (Sattolo)
+    unsigned int seed = 13579;
+    for (int i = 0; i < count; i++) order[i] = i;
+    for (int i = count - 1; i > 0; i--) {
+        seed = seed * 1664525 + 1013904223;
+        int j = (int)(seed % (unsigned int)i);
+        int tmp = order[i]; order[i] = order[j]; order[j] = tmp;
+    }
+    for (int i = 0; i < count; i++) {
+        *(char**)(buffer + (long)order[i] * 64) = buffer + (long)order[(i + 1) % count] * 64;
+    }
+
+    double ns[MLP_MAX_CHAINS];
+    char* starts[MLP_MAX_CHAINS];
+    for (int t = 0; t < num_sweep; t++) {
+        int chains = sweep[t];
+        // Chains start evenly spaced along the cycle so they never share lines
+        for (int c = 0; c < chains; c++) {
+            starts[c] = buffer + (long)order[(long)c * count / chains] * 64;
+        }
+        ns[t] = mlp_chase_ns(starts, chains, steps);
+    }
+
+    free(order);
+    free(buffer);
+
+    double peak = 1.0;
+    for (int t = 0; t < num_sweep; t++) {
+        double speedup = ns[t] > 0 ? ns[0] / ns[t] : 0.0;
+        if (speedup > peak) peak = speedup;
+    }
+    int saturation = sweep[num_sweep - 1];
+    for (int t = 0; t < num_sweep; t++) {
+        if (ns[t] > 0 && ns[0] / ns[t] >= peak * 0.9) { saturation = sweep[t]; break; }
+    }
+
+    if (out) {
+        out[0] = peak;
+        out[1] = saturation;
+        out[2] = num_sweep;
+        for (int t = 0; t < num_sweep; t++) {
+            out[3 + t * 2] = sweep[t];
+            out[4 + t * 2] = ns[t];
+        }
+    }
+    return peak;
+}
+
 // Fixed allocation pattern test
 EMSCRIPTEN_KEEPALIVE
 double allocation_pattern_test(int num_allocs, int alloc_size) {
@@ -506,45 +753,166 @@ double cache_line_size_detection() {
     return (double)likely_cache_line_size;
 }
 
-// TLB (Translation Lookaside Buffer) 检测
-EMSCRIPTEN_KEEPALIVE
-double tlb_size_detection() {
-    int page_size = 4096;  // 假设4KB页面
-    double baseline_time = 0;
-    int likely_tlb_entries = 64;  // 默认值
-
-    // 测试不同数量的页面访问
-    for (int num_pages = 16; num_pages <= 1024; num_pages *= 2) {
-        int total_size = num_pages * page_size;
-        char* buffer = malloc(total_size);
-        if (!buffer) continue;
+// TLB (Translation Lookaside Buffer) reach profile
+#define TLB_PAGE_SIZE 4096
+#define TLB_HUGE_STRIDE (2 * 1024 * 1024)
+#define TLB_MAX_POINTS 24
+
+// Randomized single-cycle pointer chase over num_nodes nodes spaced stride bytes apart.
+// With rotate set, each node's line offset rotates within its page so page-strided
+// nodes do not all alias one cache set. Returns ns per access.
+static double page_chase_ns(char* base, int num_nodes, int stride, int rotate, int steps, unsigned int seed) {
+    if (num_nodes < 2) return -1.0;
+    int* order = malloc(sizeof(int) * num_nodes);
+    if (!order) return -1.0;
+
+    for (int i = 0; i < num_nodes; i++) order[i] = i;
+    // Sattolo's algorithm: one cycle through every node, no short loops
+    for (int i = num_nodes - 1; i > 0; i--) {
+        seed = seed * 1664525 + 1013904223;
+        int j = (int)(seed % (unsigned int)i);
+        int tmp = order[i]; order[i] = order[j]; order[j] = tmp;
+    }
 
-        memset(buffer, 1, total_size);
+    for (int i = 0; i < num_nodes; i++) {
+        int from = order[i];
+        int to = order[(i + 1) % num_nodes];
+        char* from_node = base + (long)from * stride + (rotate ? (from % 64) * 64 : 0);
+        char* to_node = base + (long)to * stride + (rotate ? (to % 64) * 64 : 0);
+        *(char**)from_node = to_node;
+    }
+    char* p = base + (long)order[0] * stride + (rotate ? (order[0] % 64) * 64 : 0);
+    free(order);
+
+    // Warm pass populates caches and TLBs, then best of two timed passes
+    for (int i = 0; i < num_nodes; i++) p = *(char**)p;
+
+    double best_ns = -1.0;
+    for (int rep = 0; rep < 2; rep++) {
+        double start = probe_timer_start();
+        for (int i = 0; i < steps; i++) p = *(char**)p;
+        double ns = probe_timer_elapsed_ms(start) * 1e6 / steps;
+        if (best_ns < 0 || ns < best_ns) best_ns = ns;
+    }
 
-        volatile long sum = 0;
-        int iterations = 1000;
+    // Keep the chase live
+    if (p == NULL) best_ns += 1.0;
+    return best_ns;
+}
 
-        // 每个页面访问一次，测试TLB未命中开销
-        for (int i = 0; i < iterations; i++) {
-            for (int page = 0; page < num_pages; page++) {
-                sum += buffer[page * page_size];
-            }
-        }
+// TLB reach and page-walk penalty curve
+// Each point chases one line per 4KB page and subtracts a control chase over the same
+// number of lines packed contiguously, so data-cache misses cancel and only the
+// translation cost remains.
+// out layout (doubles):
+//   [0] L1 DTLB reach (pages)     [1] STLB reach (pages)     [2] page-walk penalty (ns)
+//   [3] L1 DTLB miss penalty (ns) [4] huge-page backing likely (0/1)
+//   [5] N, then N pairs (pages, translation ns/access) at 4KB stride
+//   then M, then M pairs (regions, ns/access) at 2MB stride
+// out must hold at least 8 + 4 * TLB_MAX_POINTS doubles. Returns the L1 DTLB reach.
+EMSCRIPTEN_KEEPALIVE
+double tlb_reach_profile(double* out, int max_pages, int steps) {
+    static const int sweep[] = {16, 24, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768,
+                                1024, 1536, 2048, 3072, 4096, 6144, 8192, 12288, 16384};
+    int num_sweep = sizeof(sweep) / sizeof(sweep[0]);
+    if (max_pages < 16) max_pages = 16;
+    if (max_pages > 16384) max_pages = 16384;
+    if (steps < 1000) steps = 1000;
+
+    int total_size = max_pages * TLB_PAGE_SIZE;
+    char* buffer = malloc(total_size);
+    if (!buffer) return -1.0;
+    memset(buffer, 1, total_size);
+
+    int pages[TLB_MAX_POINTS];
+    double ns[TLB_MAX_POINTS];
+    int n = 0;
+    for (int t = 0; t < num_sweep && sweep[t] <= max_pages; t++) {
+        double paged = page_chase_ns(buffer, sweep[t], TLB_PAGE_SIZE, 1, steps, 12345 + t);
+        double packed = page_chase_ns(buffer, sweep[t], 64, 0, steps, 12345 + t);
+        pages[n] = sweep[t];
+        ns[n] = paged - packed;
+        n++;
+    }
 
-        double current_time = (double)sum / (iterations * num_pages);
+    // Same chase at 2MB stride: one access per potential huge page
+    int regions[TLB_MAX_POINTS];
+    double huge_ns[TLB_MAX_POINTS];
+    int m = 0;
+    for (int r = 2; r * TLB_HUGE_STRIDE <= total_size && m < TLB_MAX_POINTS; r *= 2) {
+        regions[m] = r;
+        huge_ns[m] = page_chase_ns(buffer, r, TLB_HUGE_STRIDE, 1, steps, 54321 + r);
+        m++;
+    }
 
-        if (num_pages == 16) {
-            baseline_time = current_time;
-        }
+    free(buffer);
 
-        // 检测TLB未命中导致的性能下降
-        if (current_time > baseline_time * 1.5) {
-            likely_tlb_entries = num_pages / 2;
-            break;
-        }
+    // Knee detection on the translation-cost curve
+    double base = ns[0];
+    for (int i = 1; i < n && i < 3; i++) if (ns[i] < base) base = ns[i];
 
-        free(buffer);
+    int l1_idx = -1;
+    for (int i = 0; i < n; i++) {
+        if (ns[i] > base + 0.75) { l1_idx = i; break; }
+    }
+    int l1_reach = (l1_idx < 0) ? pages[n - 1] : pages[l1_idx > 0 ? l1_idx - 1 : 0];
+
+    // STLB-hit plateau: minimum of the first two points past the first knee (the second may
+    // already be climbing toward STLB misses, which would raise the threshold below)
+    double plateau = base;
+    if (l1_idx >= 0) {
+        plateau = ns[l1_idx];
+        if (l1_idx + 1 < n && ns[l1_idx + 1] < plateau) plateau = ns[l1_idx + 1];
+    }
+    int stlb_idx = -1;
+    if (l1_idx >= 0) {
+        for (int i = l1_idx + 1; i < n; i++) {
+            if (ns[i] > plateau * 1.5 + 2.0) { stlb_idx = i; break; }
+        }
+    }
+    // Tail of the curve (largest footprints): every access walks the page table
+    double tail_max = ns[n - 1], tail_sum = 0.0;
+    int tail_count = 0;
+    for (int i = (n > 3 ? n - 3 : 0); i < n; i++) {
+        if (ns[i] > tail_max) tail_max = ns[i];
+        tail_sum += ns[i];
+        tail_count++;
+    }
+    int stlb_reach = (stlb_idx < 0) ? pages[n - 1] : pages[stlb_idx - 1];
+    double walk_penalty = (stlb_idx < 0) ? 0.0 : tail_sum / tail_count - plateau;
+    double l1_penalty = (l1_idx < 0) ? 0.0 : plateau - base;
+
+    // 2MB-stride curve: with 4KB backing every region also needs its own page-table leaf, so
+    // the wider chases pay page-walk cache misses; with 2MB backing the curve stays flat
+    double huge_min = m ? huge_ns[0] : 0.0, huge_max = huge_min;
+    for (int i = 1; i < m; i++) {
+        if (huge_ns[i] < huge_min) huge_min = huge_ns[i];
+        if (huge_ns[i] > huge_max) huge_max = huge_ns[i];
+    }
+    int huge_flat = m >= 2 && huge_max <= huge_min * 1.1 + 0.75;
+
+    // No translation cost anywhere up to 32MB+ of 4KB pages exceeds every known STLB, and no
+    // growth at 2MB stride either: 2MB backing
+    int huge_likely = (pages[n - 1] >= 8192 && l1_idx < 0 && tail_max <= base + 0.75 && huge_flat) ? 1 : 0;
+
+    if (out) {
+        out[0] = l1_reach;
+        out[1] = stlb_reach;
+        out[2] = walk_penalty;
+        out[3] = l1_penalty;
+        out[4] = huge_likely;
+        int k = 5;
+        out[k++] = n;
+        for (int i = 0; i < n; i++) { out[k++] = pages[i]; out[k++] = ns[i]; }
+        out[k++] = m;
+        for (int i = 0; i < m; i++) { out[k++] = regions[i]; out[k++] = huge_ns[i]; }
     }
 
-    return (double)likely_tlb_entries;
-}
\ No newline at end of file
+    return (double)l1_reach;
+}
+
+// TLB size detection - L1 DTLB reach from the page-chase profile
+EMSCRIPTEN_KEEPALIVE
+double tlb_size_detection() {
+    return tlb_reach_profile(NULL, 16384, 100000);
+}
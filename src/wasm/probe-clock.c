@@ -0,0 +1,100 @@
+#include "probe-platform.h"
+#include "probe-clock.h"
+
+#if defined(PROBE_CLOCK_IMPORT)
+// Standalone probe modules (footprint-probe.wasm): the JS loader supplies the clock
+__attribute__((import_module("env"), import_name("probe_now_ms")))
+double probe_now_ms(void);
+#elif PROBE_HAS_JS
+// Host clock: JS side installs Module.probeClock (WASMFingerprint.now) after loading
+EM_JS(double, probe_now_ms, (), {
+    if (Module["probeClock"]) return Module["probeClock"]();
+    return performance.now();
+});
+#else
+#include <time.h>
+
+// WASI and native builds: monotonic clock (WASI clock_time_get)
+double probe_now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+#endif
+
+static double clock_resolution_ms = -1.0;
+static double spins_per_ms = 0.0;
+
+// Spin until the clock ticks; returns the new reading and the spin count
+static double spin_to_edge(long* spins) {
+    double start = probe_now_ms();
+    double t;
+    long n = 0;
+    do {
+        t = probe_now_ms();
+        n++;
+    } while (t == start);
+    *spins = n;
+    return t;
+}
+
+// Measure clock step and how many spins fit in one millisecond
+static void probe_clock_calibrate(void) {
+    long spins;
+    double prev = spin_to_edge(&spins);
+    double min_step = 1e9;
+    double rates[9];
+    int count = 0;
+
+    for (int i = 0; i < 9; i++) {
+        double edge = spin_to_edge(&spins);
+        double step = edge - prev;
+        if (step > 0) {
+            if (step < min_step) min_step = step;
+            rates[count++] = (double)spins / step;
+        }
+        prev = edge;
+    }
+
+    // Median spin rate (insertion sort, tiny array)
+    for (int i = 1; i < count; i++) {
+        double v = rates[i];
+        int j = i - 1;
+        while (j >= 0 && rates[j] > v) { rates[j + 1] = rates[j]; j--; }
+        rates[j + 1] = v;
+    }
+
+    clock_resolution_ms = (min_step < 1e9) ? min_step : 0.0;
+    spins_per_ms = count ? rates[count / 2] : 0.0;
+}
+
+// Forget calibration (JS calls this after the high-resolution timer comes up)
+EMSCRIPTEN_KEEPALIVE
+void probe_clock_reset(void) {
+    clock_resolution_ms = -1.0;
+    spins_per_ms = 0.0;
+}
+
+EMSCRIPTEN_KEEPALIVE
+double probe_clock_resolution(void) {
+    if (clock_resolution_ms < 0) probe_clock_calibrate();
+    return clock_resolution_ms;
+}
+
+// Start a measurement; on coarse clocks (>= 1µs) start exactly on a tick edge
+double probe_timer_start(void) {
+    if (clock_resolution_ms < 0) probe_clock_calibrate();
+    if (clock_resolution_ms < 0.001) return probe_now_ms();
+    long spins;
+    return spin_to_edge(&spins);
+}
+
+// Elapsed time since probe_timer_start; on coarse clocks subtract the leftover spin to the next edge
+double probe_timer_elapsed_ms(double start) {
+    if (clock_resolution_ms < 0.001) return probe_now_ms() - start;
+    long spins;
+    double edge = spin_to_edge(&spins);
+    double leftover = spins_per_ms > 0 ? (double)spins / spins_per_ms : 0.0;
+    double elapsed = edge - start - leftover;
+    return elapsed > 0 ? elapsed : 0.0;
+}
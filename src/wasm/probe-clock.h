@@ -0,0 +1,12 @@
+#ifndef PROBE_CLOCK_H
+#define PROBE_CLOCK_H
+
+// In-kernel timing shared by the probe kernels.
+// probe_now_ms() reads the host clock (Module.probeClock when the page installed the
+// high-resolution timer, otherwise performance.now()). probe_timer_start() and
+// probe_timer_elapsed_ms() add clock-edge alignment when that clock is coarse.
+double probe_now_ms(void);
+double probe_timer_start(void);
+double probe_timer_elapsed_ms(double start);
+
+#endif
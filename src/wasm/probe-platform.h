@@ -0,0 +1,15 @@
+#ifndef PROBE_PLATFORM_H
+#define PROBE_PLATFORM_H
+
+// Kernel sources build under Emscripten (browser module) and without it (wasm32-wasi,
+// native runner). Outside Emscripten EMSCRIPTEN_KEEPALIVE is a plain retained symbol and
+// PROBE_HAS_JS is 0: there is no JS host, so EM_JS code needs an alternative.
+#ifdef __EMSCRIPTEN__
+#include <emscripten.h>
+#define PROBE_HAS_JS 1
+#else
+#define EMSCRIPTEN_KEEPALIVE __attribute__((used))
+#define PROBE_HAS_JS 0
+#endif
+
+#endif
@@ -0,0 +1,77 @@
+// Relaxed SIMD probe (built separately with -msimd128 -mrelaxed-simd)
+// Relaxed SIMD lets engines return the host's native result for edge cases, so evaluating
+// the relaxed ops on crafted inputs reveals the instruction set underneath. Deterministic
+// and takes microseconds. Standalone module: no imports, see Makefile target relaxed-probe.
+#include <stdint.h>
+#include <wasm_simd128.h>
+
+#define RELAXED_FUSED_MADD      (1 << 0)  // relaxed_madd is fused (FMA hardware in use)
+#define RELAXED_SWIZZLE_X86     (1 << 1)  // index 17 selects lane 1 (pshufb uses the low 4 bits)
+#define RELAXED_TRUNC_NAN_X86   (1 << 2)  // NaN truncates to INT32_MIN (cvttps2dq), not 0
+#define RELAXED_TRUNC_U_NEG     (1 << 3)  // unsigned trunc of -1.0f is non-zero
+#define RELAXED_LANESELECT_X86  (1 << 4)  // laneselect follows the mask byte's top bit (pblendvb)
+#define RELAXED_MIN_X86         (1 << 5)  // relaxed_min(NaN, 1) returns 1 (minps), not NaN
+#define RELAXED_PROBE_COUNT 6
+
+// Inputs live in memory so the compiler cannot fold the relaxed ops at build time
+static volatile float probe_f32[4] = {1.00000011920928955f, -1.00000023841857910f, 0.0f, -1.0f};
+static volatile uint8_t probe_bytes[4] = {17, 0x80, 0xFF, 0x00};
+static volatile uint32_t probe_nan_bits = 0x7FC00000u;
+
+static uint32_t probe_raw[RELAXED_PROBE_COUNT];
+
+// Raw 32-bit lane behind bit `index` of the last relaxed_simd_probe() mask
+__attribute__((export_name("relaxed_simd_probe_raw")))
+uint32_t relaxed_simd_probe_raw(int index) {
+    return index >= 0 && index < RELAXED_PROBE_COUNT ? probe_raw[index] : 0;
+}
+
+__attribute__((export_name("relaxed_simd_probe")))
+int relaxed_simd_probe(void) {
+    int mask = 0;
+    union { uint32_t u; float f; } nan_bits = { probe_nan_bits };
+
+    // (1 + 2^-23)^2 - (1 + 2^-22) = 2^-46 when fused, 0 after rounding the product
+    v128_t a = wasm_f32x4_splat(probe_f32[0]);
+    v128_t c = wasm_f32x4_splat(probe_f32[1]);
+    float madd = wasm_f32x4_extract_lane(wasm_f32x4_relaxed_madd(a, a, c), 0);
+    union { float f; uint32_t u; } madd_bits = { madd };
+    probe_raw[0] = madd_bits.u;
+    if (madd != 0.0f) mask |= RELAXED_FUSED_MADD;
+
+    // Out-of-range index 17: x86 uses index & 15, ARM tbl returns 0
+    v128_t table = wasm_i8x16_make(10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25);
+    v128_t index = wasm_i8x16_splat((int8_t)probe_bytes[0]);
+    uint32_t swizzled = (uint8_t)wasm_i8x16_extract_lane(wasm_i8x16_relaxed_swizzle(table, index), 0);
+    probe_raw[1] = swizzled;
+    if (swizzled == 11) mask |= RELAXED_SWIZZLE_X86;
+
+    // NaN lane: x86 gives the "integer indefinite" 0x80000000, ARM saturates NaN to 0
+    v128_t nan = wasm_f32x4_splat(nan_bits.f);
+    uint32_t trunc_nan = (uint32_t)wasm_i32x4_extract_lane(wasm_i32x4_relaxed_trunc_f32x4(nan), 0);
+    probe_raw[2] = trunc_nan;
+    if (trunc_nan == 0x80000000u) mask |= RELAXED_TRUNC_NAN_X86;
+
+    // -1.0f to u32: ARM fcvtzu saturates to 0; x86 lowerings differ per engine
+    v128_t neg = wasm_f32x4_splat(probe_f32[3]);
+    uint32_t trunc_neg = (uint32_t)wasm_i32x4_extract_lane(wasm_u32x4_relaxed_trunc_f32x4(neg), 0);
+    probe_raw[3] = trunc_neg;
+    if (trunc_neg != 0) mask |= RELAXED_TRUNC_U_NEG;
+
+    // Mask byte 0x80 between 0xFF and 0x00: bitwise select gives 0x80, top-bit blend 0xFF
+    v128_t ones = wasm_i8x16_splat((int8_t)probe_bytes[2]);
+    v128_t zeros = wasm_i8x16_splat((int8_t)probe_bytes[3]);
+    v128_t sel = wasm_i8x16_splat((int8_t)probe_bytes[1]);
+    uint32_t selected = (uint8_t)wasm_i8x16_extract_lane(wasm_i8x16_relaxed_laneselect(ones, zeros, sel), 0);
+    probe_raw[4] = selected;
+    if (selected == 0xFF) mask |= RELAXED_LANESELECT_X86;
+
+    // minps returns the second operand when either is NaN; ARM fmin propagates the NaN
+    v128_t one = wasm_f32x4_splat(-probe_f32[3]);
+    float min = wasm_f32x4_extract_lane(wasm_f32x4_relaxed_min(nan, one), 0);
+    union { float f; uint32_t u; } min_bits = { min };
+    probe_raw[5] = min_bits.u;
+    if (min == min) mask |= RELAXED_MIN_X86;
+
+    return mask;
+}
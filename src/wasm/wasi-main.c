@@ -0,0 +1,182 @@
+// Standalone suite runner (wasm32-wasi and native builds)
+// Runs the browser kernels without Emscripten glue and prints one JSON object to stdout.
+// Timed kernels report best-of-N wall time after a warm-up call (which also lets JIT
+// runtimes reach their optimizing tier); probes report their own in-kernel measurement
+// from a second call. V8 has no OSR for wasm, so a probe's first call runs in the
+// baseline tier from start to end and is discarded.
+//
+// Usage: wasi-main [scale] [repeats]   scale multiplies the work per call (default 1)
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "probe-clock.h"
+
+#if defined(__wasi__)
+#define SUITE_RUNTIME "wasi"
+#elif defined(__EMSCRIPTEN__)
+#define SUITE_RUNTIME "emscripten"
+#else
+#define SUITE_RUNTIME "native"
+#endif
+
+// Kernel entry points (JS reaches them as exports, so there is no shared header)
+double sequential_access_test(int size_kb, int iterations);
+double random_access_test(int size_kb, int iterations);
+double stride_access_test(int size_kb, int stride, int iterations);
+double prefetch_pattern_test(int pattern, int param, int size_kb, int steps);
+double float_precision_test(int iterations);
+double transcendental_test(double input, int iterations);
+unsigned int libm_table_test(double* inputs, double* results, int count);
+long integer_optimization_test(int iterations);
+long branch_prediction_test(int iterations);
+double vector_computation_test(int iterations);
+double indirect_call_test(int targets, int period, int calls);
+double code_footprint_test(int family, int blocks, int block_calls);
+double branch_pattern_test(int kind, int period, int entropy_pct, int branches);
+double cpu_frequency_estimate(int adds);
+int reference_kernel(int rounds);
+double fp_op_test(int type, int op, int throughput, int iterations);
+double denormal_op_test(int type, int op, int subnormal, int iterations);
+uint32_t nan_propagation_probe(uint32_t* out);
+double call_overhead_profile(double* out, int calls);
+
+// Constants mirrored from the kernel sources
+#define PREFETCH_FORWARD 0
+#define PREFETCH_RANDOM  6
+#define BRANCH_PATTERN_LOOP 1
+#define FP_TYPE_F64 1
+#define FP_OP_ADD 0
+#define FP_OP_MUL 1
+#define FP_OP_DIV 3
+#define LIBM_COUNT 4096
+#define NAN_PROBE_WORDS 28
+
+static int suite_scale = 1;
+static int suite_steps = 200000;
+static double libm_inputs[LIBM_COUNT * 2];
+static double libm_results[LIBM_COUNT];
+
+static double run_seq_16k(void) { return sequential_access_test(16, 2000 * suite_scale); }
+static double run_rnd_16k(void) { return random_access_test(16, 2000 * suite_scale); }
+static double run_seq_256k(void) { return sequential_access_test(256, 200 * suite_scale); }
+static double run_rnd_256k(void) { return random_access_test(256, 200 * suite_scale); }
+static double run_stride_4k(void) { return stride_access_test(512, 4096, 200 * suite_scale); }
+static double run_float(void) { return float_precision_test(100000 * suite_scale); }
+static double run_transcendental(void) { return transcendental_test(1.5, 10000 * suite_scale); }
+static double run_integer(void) { return (double)integer_optimization_test(100000 * suite_scale); }
+static double run_branch(void) { return (double)branch_prediction_test(50000 * suite_scale); }
+static double run_vector(void) { return vector_computation_test(10000 * suite_scale); }
+static double run_reference(void) { return reference_kernel(65536 * suite_scale); }
+static double run_libm(void) { return libm_table_test(libm_inputs, libm_results, LIBM_COUNT); }
+
+static double probe_prefetch_forward(void) { return prefetch_pattern_test(PREFETCH_FORWARD, 0, 32768, suite_steps); }
+static double probe_prefetch_random(void) { return prefetch_pattern_test(PREFETCH_RANDOM, 0, 32768, suite_steps); }
+static double probe_indirect_mono(void) { return indirect_call_test(1, 1, suite_steps); }
+static double probe_indirect_random(void) { return indirect_call_test(64, 4096, suite_steps); }
+static double probe_branch_random(void) { return branch_pattern_test(BRANCH_PATTERN_LOOP, 1, 100, suite_steps); }
+static double probe_code_straight(void) { return code_footprint_test(0, 16, 20000 * suite_scale); }
+static double probe_fp_add_latency(void) { return fp_op_test(FP_TYPE_F64, FP_OP_ADD, 0, suite_steps); }
+static double probe_fp_add_throughput(void) { return fp_op_test(FP_TYPE_F64, FP_OP_ADD, 1, suite_steps); }
+static double probe_fp_div_latency(void) { return fp_op_test(FP_TYPE_F64, FP_OP_DIV, 0, suite_steps); }
+static double probe_cpu_ghz(void) { return cpu_frequency_estimate(1 << 22); }
+static double probe_denormal_ratio(void) {
+    double normal = denormal_op_test(FP_TYPE_F64, FP_OP_MUL, 0, suite_steps);
+    double subnormal = denormal_op_test(FP_TYPE_F64, FP_OP_MUL, 1, suite_steps);
+    return normal > 0 ? subnormal / normal : -1.0;
+}
+
+typedef struct {
+    const char* name;
+    double (*run)(void);
+} suite_kernel;
+
+typedef struct {
+    const char* name;
+    const char* unit;
+    double (*run)(void);
+} suite_probe;
+
+static const suite_kernel suite_kernels[] = {
+    {"sequential_16k", run_seq_16k},
+    {"random_16k", run_rnd_16k},
+    {"sequential_256k", run_seq_256k},
+    {"random_256k", run_rnd_256k},
+    {"stride_4096", run_stride_4k},
+    {"float_precision", run_float},
+    {"transcendental", run_transcendental},
+    {"integer_optimization", run_integer},
+    {"branch_prediction", run_branch},
+    {"vector_computation", run_vector},
+    {"reference_kernel", run_reference},
+    {"libm_table", run_libm},
+};
+
+static const suite_probe suite_probes[] = {
+    {"prefetch_forward_ns", "ns", probe_prefetch_forward},
+    {"prefetch_random_ns", "ns", probe_prefetch_random},
+    {"indirect_mono_ns", "ns", probe_indirect_mono},
+    {"indirect_random_ns", "ns", probe_indirect_random},
+    {"branch_random_ns", "ns", probe_branch_random},
+    {"code_straight_64kb_ns_per_kb", "ns/KB", probe_code_straight},
+    {"fp_f64_add_latency_ns", "ns", probe_fp_add_latency},
+    {"fp_f64_add_throughput_ns", "ns", probe_fp_add_throughput},
+    {"fp_f64_div_latency_ns", "ns", probe_fp_div_latency},
+    {"denormal_f64_mul_ratio", "x", probe_denormal_ratio},
+    {"cpu_ghz", "GHz", probe_cpu_ghz},
+};
+
+static void print_probe(const char* name, double value, const char* unit, int* first) {
+    if (!(value == value) || value > 1e300 || value < -1e300) value = -1.0;  // keep the JSON valid
+    printf("%s\n    \"%s\": {\"value\": %.6g, \"unit\": \"%s\"}", *first ? "" : ",", name, value, unit);
+    *first = 0;
+}
+
+int main(int argc, char** argv) {
+    int repeats = 5;
+    if (argc > 1) suite_scale = atoi(argv[1]) > 0 ? atoi(argv[1]) : 1;
+    if (argc > 2) repeats = atoi(argv[2]) > 0 ? atoi(argv[2]) : 5;
+
+    double suite_start = probe_now_ms();
+    printf("{\n  \"runtime\": \"%s\",\n  \"scale\": %d,\n  \"repeats\": %d,\n", SUITE_RUNTIME, suite_scale, repeats);
+
+    printf("  \"kernels\": {");
+    int count = (int)(sizeof(suite_kernels) / sizeof(suite_kernels[0]));
+    for (int k = 0; k < count; k++) {
+        double start = probe_now_ms();
+        double result = suite_kernels[k].run();
+        double first_ms = probe_now_ms() - start;
+        double best_ms = -1.0;
+        for (int r = 0; r < repeats; r++) {
+            start = probe_now_ms();
+            result = suite_kernels[k].run();
+            double ms = probe_now_ms() - start;
+            if (best_ms < 0 || ms < best_ms) best_ms = ms;
+        }
+        printf("%s\n    \"%s\": {\"ms\": %.6g, \"first_ms\": %.6g, \"result\": %.17g}",
+               k ? "," : "", suite_kernels[k].name, best_ms, first_ms, result);
+    }
+    printf("\n  },\n");
+
+    // Self-timed probes: warm-up call, then the reported call
+    int first = 1;
+    suite_steps = 200000 * suite_scale;
+    printf("  \"probes\": {");
+    int probe_count = (int)(sizeof(suite_probes) / sizeof(suite_probes[0]));
+    for (int p = 0; p < probe_count; p++) {
+        suite_probes[p].run();
+        print_probe(suite_probes[p].name, suite_probes[p].run(), suite_probes[p].unit, &first);
+    }
+
+    double calls[16];
+    call_overhead_profile(calls, suite_steps * 5);  // warm-up
+    call_overhead_profile(calls, suite_steps * 5);
+    print_probe("call_direct_ns", calls[1], "ns", &first);
+    print_probe("call_indirect_ns", calls[6], "ns", &first);
+    printf("\n  },\n");
+
+    uint32_t nan_words[NAN_PROBE_WORDS];
+    printf("  \"nan_hash\": \"%08x\",\n", (unsigned)nan_propagation_probe(nan_words));
+    printf("  \"libm_hash\": \"%08x\",\n", libm_table_test(libm_inputs, libm_results, LIBM_COUNT));
+    printf("  \"elapsed_ms\": %.6g\n}\n", probe_now_ms() - suite_start);
+    return 0;
+}
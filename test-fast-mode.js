@@ -0,0 +1,59 @@
+// Node.js fast-mode classification test
+// Runs generateFingerprint({ mode: 'fast' }) with the deterministic probes stubbed for one
+// device per ISA path and checks that consistent signals return without escalating.
+const fs = require('fs');
+const path = require('path');
+
+global.window = {};
+global.navigator = { hardwareConcurrency: 8 };
+const source = fs.readFileSync(path.join(__dirname, 'src', 'common.js'), 'utf8');
+const WASMFingerprint = new Function(`${source}; return WASMFingerprint;`)();
+
+const DEVICES = [
+    { name: 'Apple M2 (ARM + Apple GPU)', relaxed: 'arm', nan: 'arm', vendor: 'apple', renderer: 'Apple M2', escalates: false },
+    { name: 'Snapdragon laptop (ARM + Adreno)', relaxed: 'arm', nan: 'arm', vendor: 'qualcomm', renderer: 'Adreno (TM) 690', escalates: false },
+    { name: 'Intel desktop (x86 + Intel GPU)', relaxed: 'x86', nan: 'x86', vendor: 'intel', renderer: 'Intel(R) UHD Graphics 770', escalates: false },
+    { name: 'x86 without relaxed SIMD (NaN only)', relaxed: null, nan: 'x86', vendor: 'nvidia', renderer: 'NVIDIA GeForce RTX 3060', escalates: true },
+    { name: 'Contradicting ISA signals', relaxed: 'x86', nan: 'arm', vendor: 'intel', renderer: 'Intel(R) Iris(R) Xe', escalates: true }
+];
+
+function stubbedFingerprinter(device) {
+    const w = new WASMFingerprint();
+    w.initWASM = async () => ({});
+    w.loadCalibration = async () => null;
+    w.detectSIMDSupport = async () => true;
+    w.probeRelaxedSIMD = async () => device.relaxed
+        ? { supported: true, mask: device.relaxed === 'x86' ? 0x3e : 0x01, arch: device.relaxed, fma: true }
+        : { supported: false, mask: null, arch: null, fma: null };
+    w.probeNaNPropagation = async () => ({ hash: '0', defaultNaN: device.nan === 'x86' ? 'ffc00000' : '7fc00000', arch: device.nan });
+    w.measureLibmFingerprint = async () => null;
+    w._webglDeterministic = async () => ({
+        fingerprint: { basic: { renderer: device.renderer } },
+        analysis: { normalizedVendor: device.vendor }
+    });
+    // Escalation would run the whole timing suite; record it instead
+    w._generateFullFingerprint = async () => ({ features: {}, escalatedRun: true });
+    return w;
+}
+
+async function testFastMode() {
+    console.log('Starting fast-mode classification test...');
+    let failures = 0;
+    for (const device of DEVICES) {
+        try {
+            const result = await stubbedFingerprinter(device).generateFingerprint({ mode: 'fast' });
+            const fast = result.fast || result;
+            const ok = result.escalated === device.escalates;
+            if (!ok) failures++;
+            console.log(`${ok ? '✅' : '❌'} ${device.name}: ${fast.classification.family}, ` +
+                `confidence=${fast.confidence}, ${result.escalated ? 'escalated' : 'fast'}`);
+        } catch (error) {
+            failures++;
+            console.log(`❌ ${device.name} failed: ${error.message}`);
+        }
+    }
+    console.log(failures ? `\n❌ ${failures} fast-mode checks failed` : '\nFast-mode classification test completed!');
+    process.exitCode = failures ? 1 : 0;
+}
+
+testFastMode();
@@ -14,7 +14,14 @@ async function testWASM() {
         // Create WASM instance
         const wasmModule = await WebAssembly.instantiate(wasmBytes, {
             env: {
-                emscripten_resize_heap: () => false
+                emscripten_resize_heap: () => false,
+                probe_now_ms: () => performance.now(),
+                // call-tests.c EM_JS imports (only timed by call_overhead_profile)
+                call_import0: () => 1,
+                call_import1: (a) => a + 1,
+                call_import2: (a, b) => a + b,
+                call_import4: (a, b, c, d) => a + b + c + d,
+                call_import8: (a, b, c, d, e, f, g, h) => a + b + c + d + e + f + g + h
             },
             wasi_snapshot_preview1: {}
         });
@@ -4,9 +4,11 @@ WASM构建脚本
 使用Emscripten编译C代码为WebAssembly
 """
 
-import os
+import argparse
+import json
 import subprocess
 import sys
+from datetime import datetime, timezone
 from pathlib import Path
 
 def check_emscripten():
@@ -22,60 +24,179 @@ def check_emscripten():
     except FileNotFoundError:
         return False
 
-def compile_wasm():
-    """编译WASM模块"""
-    project_root = Path(__file__).parent.parent
-    src_dir = project_root / "src" / "wasm"
-    build_dir = project_root / "build"
+SOURCE_FILES = ["memory-tests.c", "compute-tests.c", "fp-tests.c", "call-tests.c", "probe-clock.c"]
+OUTPUT_NAME = "wasm-fingerprint"
 
-    # 确保构建目录存在
-    build_dir.mkdir(exist_ok=True)
+# 单独编译的源文件及其附加参数: fp-tests.c的标量吞吐链不能被自动向量化,
+# 否则 -msimd128 变体 (simd) 测到的是打包后的向量指令而不是标量流水线
+FILE_ARGS = {
+    "fp-tests.c": ['-fno-vectorize', '-fno-slp-vectorize'],
+}
 
-    # 编译命令
-    source_files = [
-        str(src_dir / "memory-test.c"),
-        str(src_dir / "compute-test.c")
+# 与Makefile的LDFLAGS一致 (EXPORT_NAME按变体单独设置)
+LINK_ARGS = [
+    '-s', 'WASM=1',
+    '-s', 'EXPORTED_RUNTIME_METHODS=["ccall","cwrap"]',
+    '-s', 'EXPORTED_FUNCTIONS=["_malloc","_free"]',
+    '-s', 'EXPORT_ALL=1',
+    '-s', 'ALLOW_MEMORY_GROWTH=1',
+    '-s', 'INITIAL_MEMORY=16MB',
+    '-s', 'MAXIMUM_MEMORY=256MB',
+    '-s', 'MODULARIZE=1',
+]
+
+# 构建矩阵: 名称 -> (编译参数, 需要的客户端能力, 预期速度先验)
+# expected_speed是相对o2的粗略先验, 用 --speeds 传入 benchmarkVariants 的实测结果覆盖
+VARIANTS = {
+    "o2":      (['-O2'], {}, 1.00),
+    "o3":      (['-O3'], {}, 1.05),
+    "os":      (['-Os'], {}, 0.90),
+    "simd":    (['-O3', '-msimd128'], {"simd": True}, 1.10),
+    "threads": (['-O3', '-pthread', '-s', 'ENVIRONMENT=web,worker'], {"threads": True}, 1.00),
+    "lto":     (['-O3', '-flto'], {}, 1.08),
+}
+
+
+def generate_sources(project_root):
+    """生成间接调用目标 (参数与Makefile相同)
+    代码体积块不进入主模块和变体, 由 make footprint-probe 单独编译"""
+    gen_dir = project_root / "build" / "gen"
+    gen = project_root / "tools" / "gen_kernels.py"
+    jobs = [
+        ['indirect', '--count', '1024', '--out', str(gen_dir / "indirect-targets.c")],
     ]
+    for job in jobs:
+        subprocess.run([sys.executable, str(gen), *job], check=True, cwd=project_root)
+    return [str(gen_dir / "indirect-targets.c")]
+
+
+def compile_args(opt_args):
+    """变体参数中的编译部分 (去掉只用于链接的 -s 设置)"""
+    args = []
+    skip = False
+    for arg in opt_args:
+        if skip:
+            skip = False
+        elif arg == '-s':
+            skip = True
+        else:
+            args.append(arg)
+    return args
 
-    output_file = str(build_dir / "wasm-tests")
 
-    emcc_args = [
+def object_commands(project_root, output_js, opt_args):
+    """FILE_ARGS中的源文件先单独编译为目标文件, 返回 (命令列表, 目标文件列表)"""
+    src_dir = project_root / "src" / "wasm"
+    commands, objects = [], []
+    for name, extra in FILE_ARGS.items():
+        obj = Path(output_js).with_name(f"{Path(output_js).stem}-{Path(name).stem}.o")
+        commands.append(['emcc', '-c', str(src_dir / name), '-o', str(obj),
+                         *compile_args(opt_args), *extra, f'-I{src_dir}'])
+        objects.append(str(obj))
+    return commands, objects
+
+
+def emcc_command(project_root, output_js, opt_args, export_name, objects=()):
+    src_dir = project_root / "src" / "wasm"
+    sources = [str(src_dir / name) for name in SOURCE_FILES if name not in FILE_ARGS]
+    sources += [*objects, *generate_sources(project_root)]
+    return [
         'emcc',
-        *source_files,
-        '-o', f'{output_file}.js',
-        '-s', 'WASM=1',
-        '-s', 'EXPORTED_RUNTIME_METHODS=["ccall","cwrap"]',
-        '-s', 'ALLOW_MEMORY_GROWTH=1',
-        '-s', 'INITIAL_MEMORY=16MB',
-        '-s', 'MAXIMUM_MEMORY=64MB',
-        '-O2',  # 优化等级
+        *sources,
+        '-o', str(output_js),
+        *opt_args,
         '--no-entry',  # 不需要main函数
-        '-s', 'MODULARIZE=1',
-        '-s', 'EXPORT_NAME="WASMModule"',
-        '-s', 'ENVIRONMENT=web',
+        f'-I{src_dir}',
+        *LINK_ARGS,
+        '-s', f'EXPORT_NAME="{export_name}"',
+        *([] if any('ENVIRONMENT' in a for a in opt_args) else ['-s', 'ENVIRONMENT=web']),
     ]
 
+
+def run_emcc(args, project_root):
+    try:
+        result = subprocess.run(args, capture_output=True, text=True, cwd=project_root)
+    except Exception as e:
+        print(f"❌ 编译过程出错: {e}")
+        return False
+    if result.returncode != 0:
+        print("❌ 编译失败:")
+        print(result.stderr)
+        return False
+    return True
+
+
+def build_module(project_root, output_js, opt_args, export_name):
+    """编译FILE_ARGS中的目标文件, 再链接出一个模块"""
+    commands, objects = object_commands(project_root, output_js, opt_args)
+    commands.append(emcc_command(project_root, output_js, opt_args, export_name, objects))
+    return all(run_emcc(command, project_root) for command in commands)
+
+
+def compile_wasm():
+    """编译默认WASM模块 (与 make all 相同)"""
+    project_root = Path(__file__).parent.parent
+    build_dir = project_root / "build"
+
+    # 确保构建目录存在
+    build_dir.mkdir(exist_ok=True)
+    output_file = build_dir / OUTPUT_NAME
+
     print("🔨 开始编译WASM模块...")
-    print(f"源文件: {', '.join(source_files)}")
+    print(f"源文件: {', '.join(SOURCE_FILES)}")
     print(f"输出目录: {build_dir}")
 
-    try:
-        result = subprocess.run(emcc_args, capture_output=True, text=True, cwd=project_root)
+    if not build_module(project_root, f'{output_file}.js', ['-O2'], 'WASMModule'):
+        return False
+    print("✅ WASM编译成功!")
+    print(f"生成文件:")
+    print(f"  - {output_file}.js")
+    print(f"  - {output_file}.wasm")
+    return True
 
-        if result.returncode == 0:
-            print("✅ WASM编译成功!")
-            print(f"生成文件:")
-            print(f"  - {output_file}.js")
-            print(f"  - {output_file}.wasm")
-            return True
-        else:
-            print("❌ 编译失败:")
-            print(result.stderr)
+
+def compile_matrix(names=None, speeds_path=None):
+    """编译构建矩阵并写出 build/variants/manifest.json"""
+    project_root = Path(__file__).parent.parent
+    variant_dir = project_root / "build" / "variants"
+    variant_dir.mkdir(parents=True, exist_ok=True)
+
+    measured = {}
+    if speeds_path:
+        measured = json.loads(Path(speeds_path).read_text(encoding="utf-8")).get("speedup", {})
+
+    entries = []
+    for name in names or VARIANTS:
+        opt_args, features, expected_speed = VARIANTS[name]
+        export_name = f"WASMModule_{name}"
+        js_path = variant_dir / f"{OUTPUT_NAME}-{name}.js"
+        wasm_path = variant_dir / f"{OUTPUT_NAME}-{name}.wasm"
+        print(f"🔨 变体 {name}: {' '.join(opt_args)}")
+        if not build_module(project_root, js_path, opt_args, export_name):
             return False
+        entries.append({
+            "name": name,
+            "js": js_path.name,
+            "wasm": wasm_path.name,
+            "exportName": export_name,
+            "flags": opt_args,
+            "features": {"simd": False, "threads": False, **features},
+            "sizeBytes": wasm_path.stat().st_size,
+            "expectedSpeed": measured.get(name, expected_speed),
+            "speedSource": "measured" if name in measured else "prior",
+        })
+
+    manifest = {
+        "generated": datetime.now(timezone.utc).isoformat(),
+        "default": "o2",
+        "variants": entries,
+    }
+    manifest_path = variant_dir / "manifest.json"
+    manifest_path.write_text(json.dumps(manifest, indent=2) + "\n", encoding="utf-8")
+    print(f"✅ 构建矩阵完成: {len(entries)} 个变体")
+    print(f"  - {manifest_path}")
+    return True
 
-    except Exception as e:
-        print(f"❌ 编译过程出错: {e}")
-        return False
 
 def create_simple_test():
     """创建简单的测试文件"""
@@ -95,7 +216,7 @@ def create_simple_test():
         const output = document.getElementById('output');
 
         // 尝试加载WASM模块
-        fetch('./build/wasm-tests.wasm')
+        fetch('./build/wasm-fingerprint.wasm')
             .then(response => {
                 if (response.ok) {
                     output.innerHTML += '<p>✅ WASM文件加载成功</p>';
@@ -134,6 +255,12 @@ def create_simple_test():
     print(f"✅ 创建测试文件: {test_file}")
 
 def main():
+    parser = argparse.ArgumentParser(description="WASM项目构建工具")
+    parser.add_argument("--matrix", action="store_true", help="编译全部构建矩阵变体并生成manifest")
+    parser.add_argument("--variants", help="只编译指定变体, 逗号分隔 (如 o3,simd)")
+    parser.add_argument("--speeds", help="benchmarkVariants 输出的JSON, 用实测速度替换先验")
+    args = parser.parse_args()
+
     print("🚀 WASM项目构建工具")
     print("=" * 40)
 
@@ -148,6 +275,14 @@ def main():
         print("  source ./emsdk_env.sh")
         sys.exit(1)
 
+    if args.matrix or args.variants:
+        names = args.variants.split(",") if args.variants else None
+        unknown = [n for n in names or [] if n not in VARIANTS]
+        if unknown:
+            print(f"❌ 未知变体: {', '.join(unknown)} (可选: {', '.join(VARIANTS)})")
+            sys.exit(1)
+        sys.exit(0 if compile_matrix(names, args.speeds) else 1)
+
     # 编译WASM
     if compile_wasm():
         print("\n📁 项目结构:")
@@ -0,0 +1,180 @@
+#!/usr/bin/env node
+/*
+Runtime comparison: the same kernel suite (src/wasm/wasi-main.c) run natively, under Node
+with default flags (V8 optimizing tier) and under --liftoff --no-wasm-tier-up (baseline tier).
+
+Usage:
+  node tools/compare-runtimes.js [--scale N] [--repeats N] [--out file.json] [--baseline file.json]
+
+Inputs (build first):
+  make native   -> build/native/wasm-fingerprint
+  make wasi     -> build/wasi/wasm-fingerprint.wasm
+
+Outputs:
+  build/runtime-comparison.json (or --out): per-kernel times, slowdown vs native for both
+  tiers, baseline/optimized gap and flags. Pass a previous report as --baseline to list
+  kernels whose slowdown regressed after a toolchain change.
+
+Flags:
+  codegen  baseline tier >= --gap (default 2x) slower than optimized: the timing depends on
+           which tier compiled the kernel, not only on the hardware
+  tax      optimized tier >= --tax (default 3x) slower than native
+*/
+
+const fs = require('fs');
+const path = require('path');
+const { execFileSync } = require('child_process');
+
+const ROOT = path.resolve(__dirname, '..');
+const NATIVE_BIN = path.join(ROOT, 'build', 'native', 'wasm-fingerprint');
+const WASI_MODULE = path.join(ROOT, 'build', 'wasi', 'wasm-fingerprint.wasm');
+const RUN_WASI = path.join(__dirname, 'run-wasi.js');
+
+const RUNTIMES = [
+  { name: 'native' },
+  { name: 'optimized', nodeFlags: [] },
+  { name: 'baseline', nodeFlags: ['--liftoff', '--no-wasm-tier-up'] }
+];
+// Probe units that are costs (lower is better); GHz and ratios are not comparable this way
+const COST_UNITS = new Set(['ns', 'ns/KB']);
+const REGRESSION_TOLERANCE = 0.15;
+
+function parseArgs(argv) {
+  const opts = { scale: 1, repeats: 5, out: path.join(ROOT, 'build', 'runtime-comparison.json'), baseline: null, gap: 2, tax: 3 };
+  for (let i = 0; i < argv.length; i++) {
+    const key = argv[i].replace(/^--/, '');
+    if (!(key in opts)) {
+      console.log('Usage: node tools/compare-runtimes.js [--scale N] [--repeats N] [--out file] [--baseline file] [--gap X] [--tax X]');
+      process.exit(1);
+    }
+    const value = argv[++i];
+    opts[key] = ['out', 'baseline'].includes(key) ? path.resolve(value) : Number(value);
+  }
+  return opts;
+}
+
+function runSuite(runtime, opts) {
+  const suiteArgs = [String(opts.scale), String(opts.repeats)];
+  const stdout = runtime.nodeFlags
+    ? execFileSync(process.execPath, [...runtime.nodeFlags, '--no-warnings', RUN_WASI, WASI_MODULE, ...suiteArgs], { encoding: 'utf8' })
+    : execFileSync(NATIVE_BIN, suiteArgs, { encoding: 'utf8' });
+  return JSON.parse(stdout);
+}
+
+// One row per timed kernel and per cost probe: { name, unit, native, optimized, baseline }
+function collectRows(results) {
+  const rows = [];
+  for (const name of Object.keys(results.native.kernels)) {
+    const row = { name, unit: 'ms' };
+    for (const r of RUNTIMES) row[r.name] = results[r.name].kernels[name] ? results[r.name].kernels[name].ms : null;
+    row.resultsMatch = RUNTIMES.every(r => results[r.name].kernels[name] &&
+      results[r.name].kernels[name].result === results.native.kernels[name].result);
+    rows.push(row);
+  }
+  for (const [name, probe] of Object.entries(results.native.probes)) {
+    if (!COST_UNITS.has(probe.unit)) continue;
+    const row = { name, unit: probe.unit };
+    for (const r of RUNTIMES) {
+      const p = results[r.name].probes[name];
+      row[r.name] = p && p.value >= 0 ? p.value : null;
+    }
+    rows.push(row);
+  }
+  return rows;
+}
+
+function ratio(a, b) {
+  return a > 0 && b > 0 ? +(a / b).toFixed(3) : null;
+}
+
+function analyze(rows, opts) {
+  for (const row of rows) {
+    row.optimizedSlowdown = ratio(row.optimized, row.native);
+    row.baselineSlowdown = ratio(row.baseline, row.native);
+    row.tierGap = ratio(row.baseline, row.optimized);
+    row.flags = [];
+    if (row.tierGap !== null && row.tierGap >= opts.gap) row.flags.push('codegen');
+    if (row.optimizedSlowdown !== null && row.optimizedSlowdown >= opts.tax) row.flags.push('tax');
+  }
+  return rows;
+}
+
+function geomean(values) {
+  const v = values.filter(x => x > 0);
+  return v.length ? +Math.exp(v.reduce((s, x) => s + Math.log(x), 0) / v.length).toFixed(3) : null;
+}
+
+function compareBaseline(rows, baselinePath) {
+  const previous = JSON.parse(fs.readFileSync(baselinePath, 'utf8'));
+  const byName = new Map(previous.rows.map(r => [r.name, r]));
+  const regressions = [];
+  for (const row of rows) {
+    const old = byName.get(row.name);
+    if (!old) continue;
+    for (const key of ['optimizedSlowdown', 'baselineSlowdown']) {
+      if (old[key] > 0 && row[key] > old[key] * (1 + REGRESSION_TOLERANCE)) {
+        regressions.push({ name: row.name, metric: key, before: old[key], after: row[key], change: ratio(row[key], old[key]) });
+      }
+    }
+  }
+  return regressions;
+}
+
+function printTable(rows) {
+  const fmt = v => (v === null ? '-' : v.toPrecision(4)).padStart(10);
+  console.log(`${'kernel'.padEnd(38)}${'native'.padStart(10)}${'optimized'.padStart(10)}${'baseline'.padStart(10)}` +
+    `${'opt/nat'.padStart(10)}${'base/nat'.padStart(10)}${'base/opt'.padStart(10)}  flags`);
+  for (const r of rows) {
+    console.log(`${(r.name + ' (' + r.unit + ')').padEnd(38)}${fmt(r.native)}${fmt(r.optimized)}${fmt(r.baseline)}` +
+      `${fmt(r.optimizedSlowdown)}${fmt(r.baselineSlowdown)}${fmt(r.tierGap)}  ${r.flags.join(',')}`);
+  }
+}
+
+function main() {
+  const opts = parseArgs(process.argv.slice(2));
+  for (const [file, target] of [[NATIVE_BIN, 'native'], [WASI_MODULE, 'wasi']]) {
+    if (!fs.existsSync(file)) {
+      console.error(`Missing ${file}. Run "make ${target}" first.`);
+      process.exit(1);
+    }
+  }
+
+  const results = {};
+  for (const runtime of RUNTIMES) {
+    console.log(`Running ${runtime.name}...`);
+    results[runtime.name] = runSuite(runtime, opts);
+  }
+
+  const rows = analyze(collectRows(results), opts);
+  const summary = {
+    generatedAt: new Date().toISOString(),
+    node: process.version,
+    v8: process.versions.v8,
+    scale: opts.scale,
+    repeats: opts.repeats,
+    optimizedSlowdown: geomean(rows.map(r => r.optimizedSlowdown)),
+    baselineSlowdown: geomean(rows.map(r => r.baselineSlowdown)),
+    tierGap: geomean(rows.map(r => r.tierGap)),
+    codegenDominated: rows.filter(r => r.flags.includes('codegen')).map(r => r.name),
+    resultMismatches: rows.filter(r => r.resultsMatch === false).map(r => r.name),
+    hashes: Object.fromEntries(RUNTIMES.map(r => [r.name, { nan: results[r.name].nan_hash, libm: results[r.name].libm_hash }]))
+  };
+  const report = { summary, rows };
+  if (opts.baseline) report.regressions = compareBaseline(rows, opts.baseline);
+
+  printTable(rows);
+  console.log(`\nGeomean slowdown vs native: optimized ${summary.optimizedSlowdown}x, baseline ${summary.baselineSlowdown}x`);
+  if (summary.codegenDominated.length) console.log(`Codegen-dominated: ${summary.codegenDominated.join(', ')}`);
+  if (report.regressions) {
+    console.log(report.regressions.length
+      ? `⚠️  ${report.regressions.length} regressions vs ${path.basename(opts.baseline)}: ` +
+        report.regressions.map(r => `${r.name} ${r.metric} ${r.before}→${r.after}`).join('; ')
+      : `No regressions vs ${path.basename(opts.baseline)}`);
+  }
+
+  fs.mkdirSync(path.dirname(opts.out), { recursive: true });
+  fs.writeFileSync(opts.out, JSON.stringify(report, null, 2));
+  console.log(`✅ Wrote ${path.relative(ROOT, opts.out)}`);
+}
+
+main();
@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+"""
+Kernel source generator
+Emits C files with large families of distinct functions that would be impractical to
+write by hand. Output goes to build/gen/ and is compiled together with src/wasm/*.c.
+
+Usage:
+  python3 tools/gen_kernels.py indirect --count 1024 --out build/gen/indirect-targets.c
+  python3 tools/gen_kernels.py footprint --straight 1024 --branchy 256 --out build/gen/footprint-blocks.c
+"""
+
+import argparse
+import sys
+from pathlib import Path
+
+HEADER = "// Generated by tools/gen_kernels.py - do not edit\n"
+
+
+def gen_indirect(count):
+    """Indirect-call targets: `count` noinline functions with distinct bodies.
+
+    Every body uses different constants so neither LLVM nor wasm-opt's duplicate
+    function elimination can fold them; each target keeps its own code address.
+    """
+    lines = [HEADER, '#include "indirect-targets.h"\n', "\n"]
+    for i in range(count):
+        mul = 2 * i + 3
+        add = (i * 2654435761) & 0x7FFF
+        lines.append(
+            f"__attribute__((noinline)) static int indirect_target_{i}(int x) "
+            f"{{ return (x ^ {add}) * {mul} + {i}; }}\n"
+        )
+    lines.append("\n")
+    lines.append(f"const indirect_target_fn indirect_targets[{count}] = {{\n")
+    for i in range(count):
+        lines.append(f"    indirect_target_{i},\n")
+    lines.append("};\n")
+    lines.append(f"const int indirect_target_count = {count};\n")
+    return "".join(lines)
+
+
+# Wasm bytes per statement `v = (v ^ K) + v`: local.get, i32.const (~5 byte LEB), xor,
+# local.get, add, local.set
+FOOTPRINT_STMT_BYTES = 13
+FOOTPRINT_ROUNDS = 78  # 4 statements per round -> ~4KB of wasm per block
+
+
+def gen_footprint(straight, branchy):
+    """Code-footprint blocks: ~4KB functions of four independent, non-foldable xor/add chains.
+
+    Straight blocks are pure xor/add rounds (front-end bound, no branches). Branchy blocks
+    put every round behind a mode-bit test with a distinct body in each arm; the mode is
+    fixed for a run, so the branches are predictable but each one occupies a BTB entry.
+    Constants come from a fixed LCG so output is reproducible.
+    """
+    state = [0x2545F491]
+
+    def konst():
+        state[0] = (state[0] * 1664525 + 1013904223) & 0xFFFFFFFF
+        return f"0x{state[0]:08x}u"
+
+    lines = [HEADER, '#include "footprint-blocks.h"\n', "\n"]
+    lines.append("#define FP_ROUND(k1, k2, k3, k4) \\\n"
+                 "    a = (a ^ k1) + a; b = (b ^ k2) + b; c = (c ^ k3) + c; d = (d ^ k4) + d;\n")
+    lines.append("#define FP_ARM(k1, k2) a = (a + k1) ^ a; b = (b + k2) ^ b;\n")
+    lines.append('#define FP_BARRIER() __asm__ volatile("")\n\n')
+
+    for i in range(straight):
+        lines.append(f"__attribute__((noinline)) static unsigned int footprint_straight_{i}"
+                     f"(unsigned int a, unsigned int mode) {{\n")
+        lines.append(f"    unsigned int b = a ^ {konst()}, c = a + {konst()}, d = mode ^ {konst()};\n")
+        for _ in range(FOOTPRINT_ROUNDS):
+            lines.append(f"    FP_ROUND({konst()}, {konst()}, {konst()}, {konst()})\n")
+        lines.append("    return a ^ b ^ c ^ d;\n}\n")
+
+    for i in range(branchy):
+        lines.append(f"__attribute__((noinline)) static unsigned int footprint_branchy_{i}"
+                     f"(unsigned int a, unsigned int mode) {{\n")
+        lines.append(f"    unsigned int b = a ^ {konst()}, c = a + {konst()}, d = mode ^ {konst()};\n")
+        for r in range(FOOTPRINT_ROUNDS // 2):
+            lines.append(f"    if (mode & {1 << (r % 31)}u) {{ FP_BARRIER(); FP_ARM({konst()}, {konst()}) }}"
+                         f" else {{ FP_ARM({konst()}, {konst()}) }}\n")
+            lines.append(f"    FP_ROUND({konst()}, {konst()}, {konst()}, {konst()})\n")
+        lines.append("    return a ^ b ^ c ^ d;\n}\n")
+
+    def table(name, prefix, count):
+        out = [f"\nconst footprint_block_fn {name}[{max(count, 1)}] = {{\n"]
+        out += [f"    {prefix}_{i},\n" for i in range(count)]
+        if count == 0:
+            out.append("    0,\n")
+        out.append("};\n")
+        return out
+
+    lines += table("footprint_straight", "footprint_straight", straight)
+    lines += table("footprint_branchy", "footprint_branchy", branchy)
+    lines.append(f"const int footprint_straight_count = {straight};\n")
+    lines.append(f"const int footprint_branchy_count = {branchy};\n")
+    lines.append(f"const int footprint_block_bytes = {FOOTPRINT_ROUNDS * 4 * FOOTPRINT_STMT_BYTES};\n")
+    return "".join(lines)
+
+
+def write_if_changed(path, content):
+    """Avoid touching the file (and triggering rebuilds) when nothing changed"""
+    path = Path(path)
+    path.parent.mkdir(parents=True, exist_ok=True)
+    if path.exists() and path.read_text(encoding="utf-8") == content:
+        return False
+    path.write_text(content, encoding="utf-8")
+    return True
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Generate C kernel sources")
+    sub = parser.add_subparsers(dest="kind", required=True)
+
+    indirect = sub.add_parser("indirect", help="distinct indirect-call targets")
+    indirect.add_argument("--count", type=int, default=1024)
+    indirect.add_argument("--out", required=True)
+
+    footprint = sub.add_parser("footprint", help="~4KB code blocks for the i-cache sweep")
+    footprint.add_argument("--straight", type=int, default=1024)
+    footprint.add_argument("--branchy", type=int, default=256)
+    footprint.add_argument("--out", required=True)
+
+    args = parser.parse_args()
+
+    if args.kind == "indirect":
+        if args.count < 1:
+            print("❌ --count must be positive", file=sys.stderr)
+            sys.exit(1)
+        content = gen_indirect(args.count)
+    elif args.kind == "footprint":
+        if args.straight < 1 or args.branchy < 0:
+            print("❌ --straight must be positive and --branchy non-negative", file=sys.stderr)
+            sys.exit(1)
+        content = gen_footprint(args.straight, args.branchy)
+
+    changed = write_if_changed(args.out, content)
+    print(f"{'✅ Generated' if changed else '✔ Up to date'}: {args.out}")
+
+
+if __name__ == "__main__":
+    main()
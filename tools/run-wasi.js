@@ -0,0 +1,35 @@
+#!/usr/bin/env node
+/*
+Run the wasm32-wasi build of the kernel suite under Node's WASI implementation.
+
+Usage:
+  node tools/run-wasi.js [module.wasm] [scale] [repeats]
+
+Build the module first with `make wasi` (default: build/wasi/wasm-fingerprint.wasm).
+The suite prints one JSON object to stdout; any other WASI runtime works too, e.g.
+  wasmtime build/wasi/wasm-fingerprint.wasm 1 5
+*/
+
+const fs = require('fs');
+const path = require('path');
+const { WASI } = require('node:wasi');
+
+const ROOT = path.resolve(__dirname, '..');
+const DEFAULT_MODULE = path.join(ROOT, 'build', 'wasi', 'wasm-fingerprint.wasm');
+
+async function main() {
+  const args = process.argv.slice(2);
+  const modulePath = args[0] && args[0].endsWith('.wasm') ? path.resolve(args.shift()) : DEFAULT_MODULE;
+  if (!fs.existsSync(modulePath)) {
+    console.error(`Missing ${modulePath}. Run "make wasi" first.`);
+    process.exit(1);
+  }
+
+  const wasi = new WASI({ version: 'preview1', args: [path.basename(modulePath), ...args], env: {} });
+  const module = await WebAssembly.compile(fs.readFileSync(modulePath));
+  const instance = await WebAssembly.instantiate(module, wasi.getImportObject());
+  const code = wasi.start(instance);
+  if (code) process.exit(code);
+}
+
+main().catch(e => { console.error(e.message); process.exit(1); });